@@ -311,8 +311,11 @@ void HeapVisualizerT<T>::updateVisualization(bool animate) {
     
     clearScene();
     
-    BinomialNode<T>* head = binomialHeap->getHead();
-    if (!head) return;
+    // Roots sit in an order-indexed array, not a sibling list
+    QList<BinomialNode<T>*> roots;
+    binomialHeap->forEachRoot([&roots](BinomialNode<T>* root) { roots.append(root); });
+    if (roots.isEmpty()) return;
+    BinomialNode<T>* head = roots.first();
     
     // Calculate positions for all nodes
     QMap<BinomialNode<T>*, NodePosition> positions;
@@ -320,11 +323,9 @@ void HeapVisualizerT<T>::updateVisualization(bool animate) {
     qreal rootY = 50;
     
     // Process each binomial tree root
-    BinomialNode<T>* root = head;
-    while (root) {
+    for (BinomialNode<T>* root : roots) {
         calculateLayout(root, currentX, rootY, positions);
         currentX += TREE_GAP;
-        root = root->getSibling();
     }
     
     // Draw all nodes
@@ -369,9 +370,7 @@ void HeapVisualizerT<T>::updateVisualization(bool animate) {
     }
 
     // Draw order labels (B0, B1, ...) above each root
-    BinomialNode<T>* rootNode = head;
-
-    while (rootNode) {
+    for (BinomialNode<T>* rootNode : roots) {
         if (positions.contains(rootNode)) {
             NodePosition pos = positions[rootNode];
 
@@ -391,15 +390,24 @@ void HeapVisualizerT<T>::updateVisualization(bool animate) {
                 pos.y - NODE_RADIUS * 2 - 10
             );
         }
-
-        rootNode = rootNode->getSibling();
     }
 
-    // Draw connections
-    root = head;
-    while (root) {
-        drawConnections(root, positions);
-        root = root->getSibling();
+    // Draw connections, plus an arrow from each root to the next one
+    for (int i = 0; i < roots.size(); i++) {
+        drawConnections(roots[i], positions);
+        if (i + 1 < roots.size()) {
+            NodePosition pos1 = positions[roots[i]];
+            NodePosition pos2 = positions[roots[i + 1]];
+
+            ArrowItem* rootArrow = new ArrowItem(
+                QPointF(pos1.x, pos1.y),
+                QPointF(pos2.x, pos2.y),
+                false
+            );
+
+            scene->addItem(rootArrow);
+            arrowItems.append(rootArrow);
+        }
     }
 }
 
@@ -459,8 +467,8 @@ void HeapVisualizerT<T>::drawConnections(
         child = child->getSibling();
     }
 
-    // Sibling -> sibling (same level)
-    BinomialNode<T>* sibling = node->getSibling();
+    // Sibling -> sibling (same level); roots are linked by updateVisualization
+    BinomialNode<T>* sibling = node->getParent() ? node->getSibling() : nullptr;
     if (sibling && positions.contains(sibling)) {
         NodePosition pos1 = positions[node];
         NodePosition pos2 = positions[sibling];
@@ -480,30 +488,24 @@ template <typename T>
 void HeapVisualizerT<T>::highlightMinNode() {
     if (!binomialHeap) return;
     
-    try {
-        T minValue = binomialHeap->getMin();
-        
-        // Find the node item with min value
-        for (auto it = nodeItemMap.begin(); it != nodeItemMap.end(); ++it) {
-            NodeItemT<T>* item = it.value();
-            if (item->getValue() == minValue) {
-                // Clear previous highlight
-                if (currentHighlightedNode) {
-                    currentHighlightedNode->setHighlighted(false);
-                }
-                
-                // Highlight new node
-                item->setHighlighted(true);
-                currentHighlightedNode = item;
-                
-                // Start timer to remove highlight after defined duration
-                highlightTimer->start(HIGHLIGHT_DURATION_MS);
-                break;
-            }
-        }
-    } catch (const std::exception& e) {
-        // Heap is empty, nothing to highlight
+    // The heap hands out the min node directly, so ties highlight the real root
+    typename BinomialHeap<T>::Handle minHandle = binomialHeap->getMinHandle();
+    if (!minHandle || !nodeItemMap.contains(minHandle->getNode())) {
+        return; // Heap is empty, nothing to highlight
     }
+    NodeItemT<T>* item = nodeItemMap.value(minHandle->getNode());
+    
+    // Clear previous highlight
+    if (currentHighlightedNode) {
+        currentHighlightedNode->setHighlighted(false);
+    }
+    
+    // Highlight new node
+    item->setHighlighted(true);
+    currentHighlightedNode = item;
+    
+    // Start timer to remove highlight after defined duration
+    highlightTimer->start(HIGHLIGHT_DURATION_MS);
 }
 
 template <typename T>
@@ -580,18 +582,15 @@ template <typename T>
 bool HeapVisualizerT<T>::isRootNode(BinomialNode<T>* node) {
     if (!node || !binomialHeap) return false;
     
-    // A root node is one that appears in the sibling list starting from head
-    BinomialNode<T>* head = binomialHeap->getHead();
-    BinomialNode<T>* current = head;
-    
-    while (current) {
-        if (current == node) {
-            return true;
+    // A root node is one the heap reports through forEachRoot
+    bool found = false;
+    binomialHeap->forEachRoot([&](BinomialNode<T>* root) {
+        if (root == node) {
+            found = true;
         }
-        current = current->getSibling();
-    }
+    });
     
-    return false;
+    return found;
 }
 
 // Type alias for backwards compatibility
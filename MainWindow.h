@@ -125,6 +125,9 @@ MainWindowT<T>::MainWindowT(QWidget* parent)
     : QMainWindow(parent), heap(nullptr) {
     
     heap = new BinomialHeap<T>();
+    // Keep keys attached to their nodes so node pointers held by the
+    // visualizer always show the key they were drawn with
+    heap->setSiftMode(BinomialHeap<T>::RELINK_NODES);
     setupUI();
     QString typeName = ValueConverter<T>::getTypeName();
     setWindowTitle(QString("Binomial Heap Visualizer - %1 Type").arg(typeName));
@@ -0,0 +1,544 @@
+// Microbenchmarks for BinomialHeap against std::priority_queue, a pairing
+// heap and a 4-ary heap. extractMinBatch64 (binomial only) drains the heap
+// 64 keys per extractMinBatch call, for comparison with extractMin.
+// binomial_scalar orders by a comparator the SIMD root scan does not
+// recognize, so it measures the heap with the pointer-chasing min scan.
+//
+// Output is CSV on stdout, one row per (heap, operation, distribution, size):
+//   heap,op,dist,n,ns_per_op,allocs_per_op
+//
+// Usage: binomial_heap_bench [--sizes 1e3,1e4,...] [--seed N]
+// The default sizes stop at 1e6; pass e.g. --sizes 1e7,1e8 for the large runs
+// (1e8 int64 keys needs several GB per heap).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "binomial_heap.hpp"
+
+// Global allocation counter, so every heap (and std::vector growth) is measured
+static std::uint64_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+	g_allocations++;
+	if (void* p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Over-aligned types (BinomialHeap's 32-byte aligned root-key cache) come here
+void* operator new(std::size_t size, std::align_val_t align) {
+	g_allocations++;
+	std::size_t a = std::size_t(align);
+#ifdef _MSC_VER
+	void* p = _aligned_malloc(size ? size : 1, a);
+#else
+	void* p = std::aligned_alloc(a, (size + a) / a * a); // a nonzero multiple of a
+#endif
+	if (p) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+#ifdef _MSC_VER
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { operator delete(p, align); }
+
+typedef std::int64_t Key;
+typedef std::chrono::steady_clock Clock;
+
+// ---------------------------------------------------------------------------
+// Reference heaps
+// ---------------------------------------------------------------------------
+
+// Two-pass pairing heap with decrease-key, erase and O(1) meld
+class PairingHeap
+{
+public:
+	struct Node {
+		Key key;
+		Node* child;
+		Node* next;
+		Node* prev; // previous sibling, or parent for a first child
+	};
+	typedef Node* Handle;
+
+	PairingHeap() : root(nullptr), count(0) {}
+	PairingHeap(const PairingHeap& other) : root(copyTree(other.root)), count(other.count) {}
+	~PairingHeap() { destroy(root); }
+
+	Handle insert(Key key) {
+		Node* n = new Node{ key, nullptr, nullptr, nullptr };
+		root = link(root, n);
+		count++;
+		return n;
+	}
+	Key extractMin() {
+		Node* old = root;
+		Key key = old->key;
+		root = combine(old->child);
+		delete old;
+		count--;
+		return key;
+	}
+	void decreaseKey(Handle n, Key key) {
+		n->key = key;
+		if (n == root) return;
+		cut(n);
+		root = link(root, n);
+	}
+	void erase(Handle n) {
+		if (n != root) {
+			cut(n);
+			n->next = nullptr;
+			root = link(root, combine(n->child));
+		}
+		else {
+			root = combine(n->child);
+		}
+		delete n;
+		count--;
+	}
+	void merge(PairingHeap& other) {
+		root = link(root, other.root);
+		count += other.count;
+		other.root = nullptr;
+		other.count = 0;
+	}
+	bool isEmpty() const { return root == nullptr; }
+
+private:
+	static Node* link(Node* a, Node* b) {
+		if (!a) return b;
+		if (!b) return a;
+		if (b->key < a->key) std::swap(a, b);
+		b->prev = a;
+		b->next = a->child;
+		if (a->child) a->child->prev = b;
+		a->child = b;
+		a->next = a->prev = nullptr;
+		return a;
+	}
+	static void cut(Node* n) {
+		if (n->prev->child == n) {
+			n->prev->child = n->next;
+		}
+		else {
+			n->prev->next = n->next;
+		}
+		if (n->next) n->next->prev = n->prev;
+		n->next = n->prev = nullptr;
+	}
+	static Node* combine(Node* first) {
+		if (!first) return nullptr;
+		std::vector<Node*> pairs;
+		while (first) {
+			Node* a = first;
+			Node* b = a->next;
+			first = b ? b->next : nullptr;
+			a->next = a->prev = nullptr;
+			if (b) b->next = b->prev = nullptr;
+			pairs.push_back(link(a, b));
+		}
+		Node* r = pairs.back();
+		for (std::size_t i = pairs.size() - 1; i-- > 0;) {
+			r = link(pairs[i], r);
+		}
+		return r;
+	}
+	// Both walks are iterative: after ascending inserts the root has about n
+	// children in one sibling chain, after descending ones the tree is a path
+	// n deep, and recursing on either overflows the stack at 1e6 keys
+	static Node* copyTree(Node* n) {
+		if (!n) return nullptr;
+		Node* top = new Node{ n->key, nullptr, nullptr, nullptr };
+		std::vector<std::pair<Node*, Node*>> pending{ { n, top } }; // (source, copy) awaiting children
+		while (!pending.empty()) {
+			Node* src = pending.back().first;
+			Node* dst = pending.back().second;
+			pending.pop_back();
+			Node* prev = dst;
+			for (Node* c = src->child; c; c = c->next) {
+				Node* copy = new Node{ c->key, nullptr, nullptr, prev };
+				if (prev == dst) {
+					dst->child = copy;
+				}
+				else {
+					prev->next = copy;
+				}
+				prev = copy;
+				pending.push_back({ c, copy });
+			}
+		}
+		return top;
+	}
+	// A node's first child is unhooked and visited before the node, with the
+	// node as its next, so no stack is needed
+	static void destroy(Node* n) {
+		while (n) {
+			if (Node* c = n->child) {
+				n->child = c->next;
+				c->next = n;
+				n = c;
+			}
+			else {
+				Node* next = n->next;
+				delete n;
+				n = next;
+			}
+		}
+	}
+
+	Node* root;
+	std::size_t count;
+};
+
+// Implicit 4-ary heap with a position table so it can decrease and erase
+class DaryHeap
+{
+public:
+	static const std::size_t D = 4;
+	typedef std::size_t Handle;
+
+	Handle insert(Key key) {
+		Handle id = pos.size();
+		pos.push_back(heap.size());
+		heap.push_back(Entry{ key, id });
+		up(heap.size() - 1);
+		return id;
+	}
+	Key extractMin() {
+		Key key = heap[0].key;
+		removeAt(0);
+		return key;
+	}
+	void decreaseKey(Handle id, Key key) {
+		heap[pos[id]].key = key;
+		up(pos[id]);
+	}
+	void erase(Handle id) { removeAt(pos[id]); }
+	// No structural meld for an implicit heap: append and re-heapify, O(n + m)
+	void merge(DaryHeap& other) {
+		for (const Entry& e : other.heap) {
+			pos.push_back(heap.size());
+			heap.push_back(Entry{ e.key, pos.size() - 1 });
+		}
+		for (std::size_t i = heap.size(); i-- > 0;) {
+			down(i);
+		}
+		other.heap.clear();
+		other.pos.clear();
+	}
+	void build(const std::vector<Key>& keys) {
+		for (Key k : keys) {
+			pos.push_back(heap.size());
+			heap.push_back(Entry{ k, pos.size() - 1 });
+		}
+		for (std::size_t i = heap.size(); i-- > 0;) {
+			down(i);
+		}
+	}
+	bool isEmpty() const { return heap.empty(); }
+
+private:
+	struct Entry {
+		Key key;
+		Handle id;
+	};
+	void place(std::size_t i, const Entry& e) {
+		heap[i] = e;
+		pos[e.id] = i;
+	}
+	void up(std::size_t i) {
+		Entry e = heap[i];
+		while (i > 0) {
+			std::size_t p = (i - 1) / D;
+			if (!(e.key < heap[p].key)) break;
+			place(i, heap[p]);
+			i = p;
+		}
+		place(i, e);
+	}
+	void down(std::size_t i) {
+		Entry e = heap[i];
+		std::size_t n = heap.size();
+		while (true) {
+			std::size_t first = i * D + 1;
+			if (first >= n) break;
+			std::size_t best = first;
+			for (std::size_t c = first + 1; c < first + D && c < n; c++) {
+				if (heap[c].key < heap[best].key) best = c;
+			}
+			if (!(heap[best].key < e.key)) break;
+			place(i, heap[best]);
+			i = best;
+		}
+		place(i, e);
+	}
+	void removeAt(std::size_t i) {
+		Entry last = heap.back();
+		heap.pop_back();
+		if (i == heap.size()) return;
+		place(i, last);
+		down(i);
+		up(pos[last.id]);
+	}
+
+	std::vector<Entry> heap;
+	std::vector<std::size_t> pos;
+};
+
+// ---------------------------------------------------------------------------
+// Adapters giving every heap the same benchmark surface
+// ---------------------------------------------------------------------------
+
+// Same order as std::less<Key>, but SimdRootScan does not know it
+struct ScalarLess
+{
+	bool operator()(Key a, Key b) const { return a < b; }
+};
+
+template <typename Allocator, typename Compare = std::less<Key>>
+struct BinomialAdapter
+{
+	typedef BinomialHeap<Key, Compare, Allocator> Heap;
+	typedef typename Heap::Handle Handle;
+	static const bool HAS_HANDLES = true;
+	static const bool HAS_BATCH = true;
+
+	Heap heap;
+
+	Handle insert(Key k) { return heap.insert(k); }
+	Key extractMin() { return heap.extractMin(); }
+	void decreaseKey(Handle h, Key k) { heap.decreaseKey(h, k); }
+	void erase(Handle h) { heap.erase(h); }
+	void merge(BinomialAdapter& other) { heap.merge(other.heap); }
+	void build(const std::vector<Key>& keys) { heap.insertRange(keys.begin(), keys.end()); }
+	void extractMinBatch(std::size_t k, Key* out) { heap.extractMinBatch(k, out); }
+};
+
+struct PriorityQueueAdapter
+{
+	typedef int Handle;
+	static const bool HAS_HANDLES = false;
+	static const bool HAS_BATCH = false;
+
+	std::priority_queue<Key, std::vector<Key>, std::greater<Key>> heap;
+
+	Handle insert(Key k) { heap.push(k); return 0; }
+	Key extractMin() { Key k = heap.top(); heap.pop(); return k; }
+	void decreaseKey(Handle, Key) {}
+	void erase(Handle) {}
+	void merge(PriorityQueueAdapter& other) {
+		while (!other.heap.empty()) {
+			heap.push(other.heap.top());
+			other.heap.pop();
+		}
+	}
+	void build(const std::vector<Key>& keys) {
+		heap = std::priority_queue<Key, std::vector<Key>, std::greater<Key>>(std::greater<Key>(), keys);
+	}
+	void extractMinBatch(std::size_t, Key*) {}
+};
+
+struct PairingAdapter
+{
+	typedef PairingHeap::Handle Handle;
+	static const bool HAS_HANDLES = true;
+	static const bool HAS_BATCH = false;
+
+	PairingHeap heap;
+
+	Handle insert(Key k) { return heap.insert(k); }
+	Key extractMin() { return heap.extractMin(); }
+	void decreaseKey(Handle h, Key k) { heap.decreaseKey(h, k); }
+	void erase(Handle h) { heap.erase(h); }
+	void merge(PairingAdapter& other) { heap.merge(other.heap); }
+	void build(const std::vector<Key>& keys) { for (Key k : keys) heap.insert(k); }
+	void extractMinBatch(std::size_t, Key*) {}
+};
+
+struct DaryAdapter
+{
+	typedef DaryHeap::Handle Handle;
+	static const bool HAS_HANDLES = true;
+	static const bool HAS_BATCH = false;
+
+	DaryHeap heap;
+
+	Handle insert(Key k) { return heap.insert(k); }
+	Key extractMin() { return heap.extractMin(); }
+	void decreaseKey(Handle h, Key k) { heap.decreaseKey(h, k); }
+	void erase(Handle h) { heap.erase(h); }
+	void merge(DaryAdapter& other) { heap.merge(other.heap); }
+	void build(const std::vector<Key>& keys) { heap.build(keys); }
+	void extractMinBatch(std::size_t, Key*) {}
+};
+
+// ---------------------------------------------------------------------------
+// Workloads
+// ---------------------------------------------------------------------------
+
+static std::vector<Key> makeKeys(const std::string& dist, std::size_t n, std::mt19937_64& rng) {
+	std::vector<Key> keys(n);
+	for (std::size_t i = 0; i < n; i++) {
+		if (dist == "uniform") keys[i] = Key(rng() >> 2);
+		else if (dist == "ascending") keys[i] = Key(i) * 4;
+		else if (dist == "descending") keys[i] = Key(n - i) * 4;
+		else keys[i] = Key(rng() % 16) << 40; // "dups": few distinct keys
+	}
+	return keys;
+}
+
+static std::uint64_t g_sink = 0; // keeps results observable so nothing is optimized away
+
+struct Measurement {
+	Clock::time_point start;
+	std::uint64_t allocs;
+	Measurement() : start(Clock::now()), allocs(g_allocations) {}
+};
+
+static void report(const char* heap, const char* op, const std::string& dist, std::size_t n,
+	const Measurement& m, std::size_t ops) {
+	double ns = std::chrono::duration<double, std::nano>(Clock::now() - m.start).count();
+	double allocs = double(g_allocations - m.allocs);
+	std::printf("%s,%s,%s,%zu,%.2f,%.3f\n", heap, op, dist.c_str(), n, ns / ops, allocs / ops);
+	std::fflush(stdout);
+}
+
+template <typename Adapter>
+static void runHeap(const char* name, const std::string& dist, const std::vector<Key>& keys, std::mt19937_64& rng) {
+	std::size_t n = keys.size();
+
+	{
+		Adapter a;
+		Measurement m;
+		for (Key k : keys) a.insert(k);
+		report(name, "insert", dist, n, m, n);
+
+		Measurement m2;
+		for (std::size_t i = 0; i < n; i++) g_sink += a.extractMin();
+		report(name, "extractMin", dist, n, m2, n);
+	}
+	if (Adapter::HAS_BATCH) {
+		// Same drain as extractMin, 64 keys per call
+		Adapter a;
+		for (Key k : keys) a.insert(k);
+		Key batch[64];
+		Measurement m;
+		for (std::size_t left = n; left > 0;) {
+			std::size_t k = left < 64 ? left : 64;
+			a.extractMinBatch(k, batch);
+			g_sink += std::uint64_t(batch[k - 1]);
+			left -= k;
+		}
+		report(name, "extractMinBatch64", dist, n, m, n);
+	}
+	{
+		Measurement m;
+		Adapter a;
+		a.build(keys);
+		report(name, "bulkBuild", dist, n, m, n);
+
+		Measurement m2;
+		Adapter copy(a);
+		report(name, "copy", dist, n, m2, n);
+		g_sink += copy.extractMin();
+	}
+	{
+		// Meld 64 heaps of n/64 elements one after another
+		const std::size_t parts = 64;
+		std::vector<Adapter> heaps(parts);
+		for (std::size_t i = 0; i < n; i++) heaps[i % parts].insert(keys[i]);
+		Measurement m;
+		for (std::size_t i = 1; i < parts; i++) heaps[0].merge(heaps[i]);
+		report(name, "meld", dist, n, m, parts - 1);
+	}
+	if (Adapter::HAS_HANDLES) {
+		std::vector<typename Adapter::Handle> handles(n);
+		std::vector<Key> current(keys);
+		Adapter a;
+		for (std::size_t i = 0; i < n; i++) handles[i] = a.insert(keys[i]);
+		std::vector<std::size_t> order(n);
+		for (std::size_t i = 0; i < n; i++) order[i] = i;
+		std::shuffle(order.begin(), order.end(), rng);
+
+		Measurement m;
+		for (std::size_t i : order) {
+			current[i] -= Key(rng() % 1024) + 1;
+			a.decreaseKey(handles[i], current[i]);
+		}
+		report(name, "decreaseKey", dist, n, m, n);
+
+		std::shuffle(order.begin(), order.end(), rng);
+		Measurement m2;
+		for (std::size_t i : order) a.erase(handles[i]);
+		report(name, "delete", dist, n, m2, n);
+	}
+}
+
+static std::vector<std::size_t> parseSizes(const char* arg) {
+	std::vector<std::size_t> sizes;
+	std::string s(arg);
+	std::size_t start = 0;
+	while (start <= s.size()) {
+		std::size_t end = s.find(',', start);
+		if (end == std::string::npos) end = s.size();
+		std::string item = s.substr(start, end - start);
+		if (!item.empty()) sizes.push_back(std::size_t(std::strtod(item.c_str(), nullptr)));
+		start = end + 1;
+	}
+	return sizes;
+}
+
+int main(int argc, char** argv) {
+	std::vector<std::size_t> sizes = { 1000, 10000, 100000, 1000000 };
+	std::uint64_t seed = 42;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+			sizes = parseSizes(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else {
+			std::fprintf(stderr, "usage: %s [--sizes 1e3,1e4,...] [--seed N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	const char* dists[] = { "uniform", "ascending", "descending", "dups" };
+	std::printf("heap,op,dist,n,ns_per_op,allocs_per_op\n");
+	for (std::size_t n : sizes) {
+		for (const char* dist : dists) {
+			std::mt19937_64 rng(seed);
+			std::vector<Key> keys = makeKeys(dist, n, rng);
+			runHeap<BinomialAdapter<NewDeleteNodeAllocator<Key>>>("binomial", dist, keys, rng);
+			runHeap<BinomialAdapter<PoolNodeAllocator<Key>>>("binomial_pool", dist, keys, rng);
+			runHeap<BinomialAdapter<NewDeleteNodeAllocator<Key>, ScalarLess>>("binomial_scalar", dist, keys, rng);
+			runHeap<PriorityQueueAdapter>("std_priority_queue", dist, keys, rng);
+			runHeap<PairingAdapter>("pairing", dist, keys, rng);
+			runHeap<DaryAdapter>("dary4", dist, keys, rng);
+		}
+	}
+	std::fprintf(stderr, "checksum %llu\n", (unsigned long long)g_sink);
+	return 0;
+}
@@ -0,0 +1,125 @@
+// Producer-heavy pipeline: P producer threads feed one consumer thread.
+//
+//   buffered_heap_bench [--producers 1,2,4,...] [--items N] [--thresholds 64,1024,...]
+//
+// Compares producers inserting straight into a mutex-guarded BinomialHeap
+// with BufferedBinomialHeap, where producers stage into private heaps and
+// meld them into the shared one. The consumer checks that every item arrives
+// exactly once (exit code 1 otherwise). CSV on stdout:
+//   queue,producers,threshold,items,ns_per_item,mitems_per_s
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "buffered_binomial_heap.hpp"
+
+typedef std::int64_t Key;
+typedef std::chrono::steady_clock Clock;
+
+static std::vector<std::size_t> parseList(const char* arg) {
+	std::vector<std::size_t> values;
+	for (const char* p = arg; *p;) {
+		char* end;
+		double v = std::strtod(p, &end);
+		if (end == p) break;
+		values.push_back(std::size_t(v));
+		p = (*end == ',') ? end + 1 : end;
+	}
+	return values;
+}
+
+// Runs producers plus one consumer; produce(t) must insert keys t, t + P, ...
+template <typename Produce, typename Consume>
+static bool pipeline(const char* name, std::size_t producers, std::size_t threshold, std::size_t items,
+	Produce produce, Consume tryConsume) {
+	std::size_t perProducer = items / producers;
+	std::size_t total = perProducer * producers;
+	std::vector<std::uint8_t> seen(total, 0);
+	std::size_t bad = 0;
+
+	Clock::time_point start = Clock::now();
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < producers; t++) {
+		threads.emplace_back([&, t] { produce(t, perProducer); });
+	}
+	std::thread consumer([&] {
+		Key k;
+		for (std::size_t got = 0; got < total;) {
+			if (tryConsume(k)) {
+				if (std::size_t(k) >= total || seen[std::size_t(k)]++) bad++;
+				got++;
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	});
+	for (std::thread& th : threads) th.join();
+	consumer.join();
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::printf("%s,%zu,%zu,%zu,%.2f,%.3f%s\n", name, producers, threshold, total,
+		seconds * 1e9 / total, total / seconds / 1e6, bad ? ",FAILED" : "");
+	return bad == 0;
+}
+
+int main(int argc, char** argv) {
+	std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::size_t> producers;
+	for (std::size_t p = 1; p <= 2 * hw; p *= 2) producers.push_back(p);
+	std::vector<std::size_t> thresholds = { 64, 1024, 16384 };
+	std::size_t items = 2000000;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--producers") == 0 && i + 1 < argc) producers = parseList(argv[++i]);
+		else if (std::strcmp(argv[i], "--thresholds") == 0 && i + 1 < argc) thresholds = parseList(argv[++i]);
+		else if (std::strcmp(argv[i], "--items") == 0 && i + 1 < argc) items = std::size_t(std::strtod(argv[++i], nullptr));
+		else {
+			std::fprintf(stderr, "usage: %s [--producers 1,2,4,...] [--items N] [--thresholds 64,1024,...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	bool ok = true;
+	std::printf("queue,producers,threshold,items,ns_per_item,mitems_per_s\n");
+	for (std::size_t p : producers) {
+		{
+			std::mutex mutex;
+			BinomialHeap<Key> heap;
+			ok = pipeline("mutex_heap", p, 1, items,
+				[&](std::size_t t, std::size_t n) {
+					for (std::size_t i = 0; i < n; i++) {
+						std::lock_guard<std::mutex> guard(mutex);
+						heap.insert(Key(i * p + t));
+					}
+				},
+				[&](Key& k) {
+					std::lock_guard<std::mutex> guard(mutex);
+					if (heap.isEmpty()) return false;
+					k = heap.extractMin();
+					return true;
+				}) && ok;
+		}
+		for (std::size_t threshold : thresholds) {
+			BufferedBinomialHeap<Key> heap(threshold);
+			ok = pipeline("buffered", p, threshold, items,
+				[&](std::size_t t, std::size_t n) {
+					BufferedBinomialHeap<Key>::Producer producer(heap);
+					for (std::size_t i = 0; i < n; i++) {
+						producer.insert(Key(i * p + t));
+					}
+					// Hand over the tail below the threshold now, not at destruction
+					if (producer.stagedSize() != 0) {
+						producer.flush();
+					}
+				},
+				[&](Key& k) { return heap.tryExtractMin(k); }) && ok;
+		}
+	}
+	return ok ? 0 : 1;
+}
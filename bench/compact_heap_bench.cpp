@@ -0,0 +1,180 @@
+// Large-heap comparison of the pointer-based BinomialHeap (new/delete and pool
+// allocators) with CompactBinomialHeap's index-based node arrays.
+//
+//   compact_heap_bench [--sizes 1e6,1e7,...] [--ops N] [--heap binomial|binomial_pool|compact] [--seed N]
+//
+// For each size n the heap is built from n random 32-bit keys, then runs
+// --ops (default 1e6) decreaseKeys on random live elements, then --ops
+// extractMins. At these sizes both operations are dominated by cache misses
+// while following parent / sibling links, so ns_per_op tracks the node
+// footprint; to count the misses directly, run a single heap under e.g.
+//   perf stat -e cache-misses,LLC-load-misses compact_heap_bench --heap compact
+// bytes_per_elem is the memory the built heap holds from operator new (plus a
+// 16-byte header per allocation, as malloc charges), over n.
+// CSV on stdout: heap,n,op,ns_per_op,bytes_per_elem
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "binomial_heap.hpp"
+#include "compact_binomial_heap.hpp"
+
+// Live-byte accounting; the size is kept in a header in front of each block
+static std::size_t g_liveBytes = 0;
+static const std::size_t HEADER = 16;
+
+void* operator new(std::size_t size) {
+	char* p = static_cast<char*>(std::malloc(size + HEADER));
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	*reinterpret_cast<std::size_t*>(p) = size;
+	g_liveBytes += size + HEADER;
+	return p + HEADER;
+}
+void operator delete(void* p) noexcept {
+	if (!p) return;
+	char* block = static_cast<char*>(p) - HEADER;
+	g_liveBytes -= *reinterpret_cast<std::size_t*>(block) + HEADER;
+	std::free(block);
+}
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+// Over-aligned types (BinomialHeap's 32-byte aligned root-key cache) come
+// here. The block starts max(align, HEADER) bytes early so the returned
+// pointer keeps its alignment; the size still sits just in front of it.
+static std::size_t alignedOffset(std::align_val_t align) {
+	return std::size_t(align) > HEADER ? std::size_t(align) : HEADER;
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+	std::size_t a = std::size_t(align);
+	std::size_t offset = alignedOffset(align);
+#ifdef _MSC_VER
+	char* block = static_cast<char*>(_aligned_malloc(size + offset, a));
+#else
+	char* block = static_cast<char*>(std::aligned_alloc(a, (size + offset + a - 1) / a * a));
+#endif
+	if (!block) {
+		throw std::bad_alloc();
+	}
+	char* p = block + offset;
+	*reinterpret_cast<std::size_t*>(p - HEADER) = size;
+	g_liveBytes += size + HEADER;
+	return p;
+}
+void operator delete(void* p, std::align_val_t align) noexcept {
+	if (!p) return;
+	char* q = static_cast<char*>(p);
+	g_liveBytes -= *reinterpret_cast<std::size_t*>(q - HEADER) + HEADER;
+#ifdef _MSC_VER
+	_aligned_free(q - alignedOffset(align));
+#else
+	std::free(q - alignedOffset(align));
+#endif
+}
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { operator delete(p, align); }
+
+typedef std::int32_t Key;
+typedef std::chrono::steady_clock Clock;
+
+static std::uint64_t g_sink = 0;
+
+static std::vector<std::size_t> parseList(const char* arg) {
+	std::vector<std::size_t> values;
+	for (const char* p = arg; *p;) {
+		char* end;
+		double v = std::strtod(p, &end);
+		if (end == p) break;
+		values.push_back(std::size_t(v));
+		p = (*end == ',') ? end + 1 : end;
+	}
+	return values;
+}
+
+static double nsSince(Clock::time_point start, std::size_t ops) {
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / double(ops ? ops : 1);
+}
+
+template <typename Heap>
+static void run(const char* name, std::size_t n, std::size_t ops, std::uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	std::vector<Key> keys(n);
+	for (Key& k : keys) {
+		k = Key(rng() >> 34); // 30-bit keys leave room to decrease
+	}
+	std::vector<typename Heap::Handle> handles(n);
+
+	std::size_t baseBytes = g_liveBytes;
+	Heap* heap = new Heap();
+	Clock::time_point start = Clock::now();
+	for (std::size_t i = 0; i < n; i++) {
+		handles[i] = heap->insert(keys[i]);
+	}
+	double buildNs = nsSince(start, n);
+	double bytes = double(g_liveBytes - baseBytes) / double(n);
+	std::printf("%s,%zu,insert,%.2f,%.1f\n", name, n, buildNs, bytes);
+
+	// Decrease targets are drawn up front so the timed loop is just the heap
+	std::vector<std::uint32_t> targets(ops);
+	std::vector<Key> deltas(ops);
+	for (std::size_t i = 0; i < ops; i++) {
+		targets[i] = std::uint32_t(rng() % n);
+		deltas[i] = Key(rng() % 1024) + 1;
+	}
+	start = Clock::now();
+	for (std::size_t i = 0; i < ops; i++) {
+		std::uint32_t t = targets[i];
+		keys[t] -= deltas[i];
+		heap->decreaseKey(handles[t], keys[t]);
+	}
+	std::printf("%s,%zu,decreaseKey,%.2f,%.1f\n", name, n, nsSince(start, ops), bytes);
+
+	std::size_t pops = ops < n ? ops : n;
+	start = Clock::now();
+	for (std::size_t i = 0; i < pops; i++) {
+		g_sink += std::uint64_t(heap->extractMin());
+	}
+	std::printf("%s,%zu,extractMin,%.2f,%.1f\n", name, n, nsSince(start, pops), bytes);
+	std::fflush(stdout);
+	delete heap;
+}
+
+int main(int argc, char** argv) {
+	std::vector<std::size_t> sizes = { 1000000, 10000000 };
+	std::size_t ops = 1000000;
+	std::uint64_t seed = 1;
+	std::string only;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) sizes = parseList(argv[++i]);
+		else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) ops = std::size_t(std::strtod(argv[++i], nullptr));
+		else if (std::strcmp(argv[i], "--heap") == 0 && i + 1 < argc) only = argv[++i];
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+		else {
+			std::fprintf(stderr, "usage: %s [--sizes 1e6,1e7,...] [--ops N] "
+				"[--heap binomial|binomial_pool|compact] [--seed N]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	std::printf("heap,n,op,ns_per_op,bytes_per_elem\n");
+	for (std::size_t n : sizes) {
+		if (n == 0) continue;
+		if (only.empty() || only == "binomial") {
+			run<BinomialHeap<Key>>("binomial", n, ops, seed);
+		}
+		if (only.empty() || only == "binomial_pool") {
+			run<BinomialHeap<Key, std::less<Key>, PoolNodeAllocator<Key>>>("binomial_pool", n, ops, seed);
+		}
+		if (only.empty() || only == "compact") {
+			run<CompactBinomialHeap<Key>>("compact", n, ops, seed);
+		}
+	}
+	std::fprintf(stderr, "checksum %llu\n", (unsigned long long)g_sink);
+	return 0;
+}
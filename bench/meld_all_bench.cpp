@@ -0,0 +1,103 @@
+// End-of-epoch combine: k per-partition heaps melded into one.
+//
+//   meld_all_bench [--k 64,256,...] [--n N] [--threads 0,1,2,4,...]
+//
+// Compares melding the heaps one at a time into an accumulator with
+// BinomialHeap::meldAll at several thread counts. Partitions are filled either
+// eagerly or in lazy insert mode; lazy partitions still have to carry their
+// pending roots into the root array during the meld, which is the part that
+// parallelizes. Thread count 0 is meldAll's default, which stays sequential
+// unless there are enough pending roots to pay for the threads. Results so
+// far come from machines with a few cores; scaling on 8-64 cores is untested.
+// CSV on stdout: mode,k,n,method,threads,ms,speedup
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include "binomial_heap.hpp"
+
+typedef std::int64_t Key;
+typedef BinomialHeap<Key, std::less<Key>, PoolNodeAllocator<Key>> Heap;
+typedef std::chrono::steady_clock Clock;
+
+static std::vector<std::size_t> parseList(const char* arg) {
+	std::vector<std::size_t> values;
+	for (const char* p = arg; *p;) {
+		char* end;
+		double v = std::strtod(p, &end);
+		if (end == p) break;
+		values.push_back(std::size_t(v));
+		p = (*end == ',') ? end + 1 : end;
+	}
+	return values;
+}
+
+static std::vector<Heap> partitions(std::size_t k, std::size_t n, bool lazy) {
+	std::vector<Heap> heaps(k);
+	std::mt19937_64 rng(11);
+	for (Heap& h : heaps) {
+		h.setInsertMode(lazy ? Heap::LAZY : Heap::EAGER);
+	}
+	for (std::size_t i = 0; i < n; i++) {
+		heaps[i % k].insert(Key(rng() >> 1));
+	}
+	return heaps;
+}
+
+int main(int argc, char** argv) {
+	std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::size_t> ks = { 64, 256, 1024 };
+	std::vector<std::size_t> threads(1, 0);
+	for (std::size_t t = 1; t <= hw; t *= 2) threads.push_back(t);
+	if (threads.back() != hw) threads.push_back(hw);
+	std::size_t n = 4000000;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--k") == 0 && i + 1 < argc) ks = parseList(argv[++i]);
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = parseList(argv[++i]);
+		else if (std::strcmp(argv[i], "--n") == 0 && i + 1 < argc) n = std::size_t(std::strtod(argv[++i], nullptr));
+		else {
+			std::fprintf(stderr, "usage: %s [--k 64,256,...] [--n N] [--threads 0,1,2,4,...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	std::printf("mode,k,n,method,threads,ms,speedup\n");
+	Key checksum = 0;
+	for (bool lazy : { false, true }) {
+		const char* mode = lazy ? "lazy" : "eager";
+		for (std::size_t k : ks) {
+			double sequentialMs;
+			{
+				std::vector<Heap> heaps = partitions(k, n, lazy);
+				Clock::time_point start = Clock::now();
+				Heap all;
+				for (Heap& h : heaps) {
+					all.merge(h);
+				}
+				sequentialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+				checksum += all.getMin();
+				std::printf("%s,%zu,%zu,sequential,1,%.3f,1.00\n", mode, k, n, sequentialMs);
+			}
+			for (std::size_t t : threads) {
+				std::vector<Heap> heaps = partitions(k, n, lazy);
+				Clock::time_point start = Clock::now();
+				Heap all = Heap::meldAll(heaps.begin(), heaps.end(), unsigned(t));
+				double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+				checksum += all.getMin();
+				if (all.size() != n) {
+					std::fprintf(stderr, "meldAll lost elements: %zu of %zu\n", all.size(), n);
+					return 1;
+				}
+				std::printf("%s,%zu,%zu,meldAll,%zu,%.3f,%.2f\n", mode, k, n, t, ms, sequentialMs / ms);
+			}
+		}
+	}
+	std::fprintf(stderr, "checksum %lld\n", (long long)checksum);
+	return 0;
+}
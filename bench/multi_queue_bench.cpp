@@ -0,0 +1,212 @@
+// Stress test and scaling benchmark for BinomialMultiQueue.
+//
+//   multi_queue_bench [--threads 1,2,4,...] [--ops N] [--prefill N] [--c C]
+//
+// Three parts, all printed as CSV sections:
+//  - stress:  producers insert unique keys while consumers extract; afterwards
+//             every key must have come out exactly once (exit code 1 if not)
+//  - scaling: throughput of a 50/50 insert/extract mix per thread count, for
+//             the MultiQueue and for one BinomialHeap behind a std::mutex
+//  - rank:    rank error of extracted elements (0 = true minimum) per shard
+//             count, measured single-threaded so it reflects the two-choice
+//             policy itself
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "binomial_multi_queue.hpp"
+
+typedef std::int64_t Key;
+typedef std::chrono::steady_clock Clock;
+
+struct LockedHeap
+{
+	explicit LockedHeap(std::size_t) {}
+
+	void insert(Key k) {
+		std::lock_guard<std::mutex> guard(mutex);
+		heap.insert(k);
+	}
+	bool tryExtractMin(Key& out) {
+		std::lock_guard<std::mutex> guard(mutex);
+		if (heap.isEmpty()) return false;
+		out = heap.extractMin();
+		return true;
+	}
+
+	std::mutex mutex;
+	BinomialHeap<Key> heap;
+};
+
+struct MultiQueue : BinomialMultiQueue<Key>
+{
+	static std::size_t c;
+	explicit MultiQueue(std::size_t threads) : BinomialMultiQueue<Key>(threads, c) {}
+};
+std::size_t MultiQueue::c = 2;
+
+static std::vector<std::size_t> parseList(const char* arg) {
+	std::vector<std::size_t> values;
+	for (const char* p = arg; *p;) {
+		char* end;
+		double v = std::strtod(p, &end);
+		if (end == p) break;
+		values.push_back(std::size_t(v));
+		p = (*end == ',') ? end + 1 : end;
+	}
+	return values;
+}
+
+template <typename Fn>
+static double runThreads(std::size_t threads, Fn fn) {
+	std::vector<std::thread> pool;
+	std::atomic<std::size_t> ready(0);
+	std::atomic<bool> go(false);
+	for (std::size_t t = 0; t < threads; t++) {
+		pool.emplace_back([&, t] {
+			ready++;
+			while (!go.load()) std::this_thread::yield();
+			fn(t);
+		});
+	}
+	while (ready.load() != threads) std::this_thread::yield();
+	Clock::time_point start = Clock::now();
+	go = true;
+	for (std::thread& th : pool) th.join();
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Producers insert keys t, t + T, t + 2T, ...; consumers extract concurrently
+static bool stress(std::size_t threads, std::size_t perThread) {
+	MultiQueue queue(threads);
+	std::size_t total = threads * perThread;
+	std::vector<std::atomic<std::uint8_t>> seen(total);
+	for (auto& s : seen) s.store(0);
+	std::atomic<std::size_t> extracted(0);
+
+	runThreads(2 * threads, [&](std::size_t t) {
+		if (t < threads) {
+			for (std::size_t i = 0; i < perThread; i++) {
+				queue.insert(Key(i * threads + t));
+			}
+		}
+		else {
+			std::size_t misses = 0;
+			Key k;
+			while (extracted.load(std::memory_order_relaxed) < total && misses < 1000000) {
+				if (queue.tryExtractMin(k)) {
+					seen[std::size_t(k)]++;
+					extracted++;
+					misses = 0;
+				}
+				else {
+					misses++;
+					std::this_thread::yield();
+				}
+			}
+		}
+	});
+	Key k;
+	while (queue.tryExtractMin(k)) {
+		seen[std::size_t(k)]++;
+		extracted++;
+	}
+
+	std::size_t bad = 0;
+	for (auto& s : seen) bad += (s.load() != 1);
+	std::printf("stress,%zu,%zu,%zu,%s\n", threads, total, bad, bad == 0 && queue.isEmpty() ? "ok" : "FAILED");
+	return bad == 0 && queue.isEmpty();
+}
+
+template <typename Queue>
+static void scaling(const char* name, std::size_t threads, std::size_t ops, std::size_t prefill) {
+	Queue queue(threads);
+	std::mt19937_64 rng(7);
+	for (std::size_t i = 0; i < prefill; i++) queue.insert(Key(rng() >> 1));
+
+	std::size_t perThread = ops / threads;
+	std::atomic<std::uint64_t> sink(0);
+	double seconds = runThreads(threads, [&](std::size_t t) {
+		std::mt19937_64 local(t + 1);
+		std::uint64_t acc = 0;
+		Key k;
+		for (std::size_t i = 0; i < perThread; i++) {
+			if (i & 1) {
+				if (queue.tryExtractMin(k)) acc += std::uint64_t(k);
+			}
+			else {
+				queue.insert(Key(local() >> 1));
+			}
+		}
+		sink += acc;
+	});
+	double done = double(perThread * threads);
+	std::printf("scaling,%s,%zu,%.0f,%.2f,%.3f\n", name, threads, done, seconds * 1e9 / done, done / seconds / 1e6);
+}
+
+// Fenwick tree over key ranks, to count how many smaller keys remain
+static void rankError(std::size_t shards, std::size_t n, std::size_t pops) {
+	BinomialMultiQueue<Key> queue(shards, 1);
+	std::vector<Key> keys(n);
+	for (std::size_t i = 0; i < n; i++) keys[i] = Key(i);
+	std::shuffle(keys.begin(), keys.end(), std::mt19937_64(3));
+	for (Key k : keys) queue.insert(k);
+
+	std::vector<std::uint32_t> tree(n + 1, 0);
+	auto add = [&](std::size_t i, int delta) { for (i++; i <= n; i += i & (~i + 1)) tree[i] += delta; };
+	auto prefix = [&](std::size_t i) { std::uint64_t s = 0; for (; i > 0; i -= i & (~i + 1)) s += tree[i]; return s; };
+	for (std::size_t i = 0; i < n; i++) add(i, 1);
+
+	double sum = 0;
+	std::uint64_t worst = 0;
+	pops = std::min(pops, n);
+	for (std::size_t p = 0; p < pops; p++) {
+		Key k;
+		queue.tryExtractMin(k);
+		std::uint64_t rank = prefix(std::size_t(k)); // remaining keys smaller than k
+		sum += double(rank);
+		worst = std::max(worst, rank);
+		add(std::size_t(k), -1);
+	}
+	std::printf("rank,%zu,%zu,%.2f,%llu\n", shards, pops, sum / pops, (unsigned long long)worst);
+}
+
+int main(int argc, char** argv) {
+	std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::size_t> threads;
+	for (std::size_t t = 1; t <= 2 * hw; t *= 2) threads.push_back(t);
+	std::size_t ops = 4000000, prefill = 1000000;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = parseList(argv[++i]);
+		else if (std::strcmp(argv[i], "--ops") == 0 && i + 1 < argc) ops = std::size_t(std::strtod(argv[++i], nullptr));
+		else if (std::strcmp(argv[i], "--prefill") == 0 && i + 1 < argc) prefill = std::size_t(std::strtod(argv[++i], nullptr));
+		else if (std::strcmp(argv[i], "--c") == 0 && i + 1 < argc) MultiQueue::c = std::strtoull(argv[++i], nullptr, 10);
+		else {
+			std::fprintf(stderr, "usage: %s [--threads 1,2,4,...] [--ops N] [--prefill N] [--c C]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	bool ok = true;
+	std::printf("part,threads,keys,bad,status\n");
+	for (std::size_t t : threads) ok = stress(t, 100000) && ok;
+
+	std::printf("\npart,queue,threads,ops,ns_per_op,mops_per_s\n");
+	for (std::size_t t : threads) {
+		scaling<MultiQueue>("multiqueue", t, ops, prefill);
+		scaling<LockedHeap>("mutex_heap", t, ops, prefill);
+	}
+
+	std::printf("\npart,shards,pops,mean_rank,max_rank\n");
+	for (std::size_t shards : { 2, 4, 8, 16, 32, 64, 128 }) rankError(shards, 1000000, 100000);
+	return ok ? 0 : 1;
+}
@@ -1,80 +1,257 @@
 #ifndef BINOMIALHEAP_H_
 #define BINOMIALHEAP_H_
 
-
-#define DEBUG false
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "binomial_heap_allocator.hpp"
+#include "binomial_heap_compare.hpp"
+#include "binomial_heap_simd.hpp"
+#include "binomial_heap_stats.hpp"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 template <typename B>
 class BinomialNode;
 
 template <typename B>
-class BinomialHeap
+class BinomialLocator;
+
+// Compare orders the keys like std::less: getMin/extractMin return the key
+// that compares before all others (pass std::greater<B> for a max-heap).
+// It is held in a private base (binomial_heap_compare.hpp) so that stateless
+// comparators take no space; function pointers are stored as a member.
+// Stats receives instrumentation hooks (see binomial_heap_stats.hpp); the
+// default NoHeapStats is also an empty base and compiles to nothing.
+// For int32/int64/float/double keys under std::less the minimum root is found
+// with vector compares over a cached copy of the root keys (binomial_heap_simd.hpp).
+template <typename B, typename Compare = std::less<B>, typename Allocator = NewDeleteNodeAllocator<B>,
+	typename Stats = NoHeapStats>
+class BinomialHeap : private CompareHolder<Compare>, private Stats
 {
+	typedef CompareHolder<Compare> CompareBase;
 
 public:
 	
 	friend class BinomialNode<B>;
 
+	// Stable reference to an inserted element. Stays valid until the element
+	// is removed from the heap, no matter how its key moves between nodes.
+	typedef BinomialLocator<B>* Handle;
+
+	// EAGER carries every insert into the order-indexed root array. LAZY just
+	// prepends a B0 root to a pending list (O(1) worst case) and leaves the
+	// linking to the next extractMin, erase or merge, which carries the whole
+	// pending list into the array in one pass.
+	enum InsertMode {
+		EAGER,
+		LAZY
+	};
+
+	// How decreaseKey and erase move an element towards its root.
+	// SWAP_KEYS exchanges keys between parent and child (cheap for small keys).
+	// RELINK_NODES exchanges the nodes themselves, so keys never move and a
+	// BinomialNode<B>* keeps the same key for as long as it is in the heap. The
+	// cost is a walk of the sibling lists at each level instead of a key swap.
+	enum SiftMode {
+		SWAP_KEYS,
+		RELINK_NODES
+	};
+
 	BinomialHeap();
+	explicit BinomialHeap(const Compare& comp);
+	template <typename Iterator>
+	BinomialHeap(Iterator first, Iterator last, const Compare& comp = Compare());
 	BinomialHeap(const BinomialHeap& other);
+	BinomialHeap(BinomialHeap&& other) noexcept;
 	BinomialHeap& operator=(const BinomialHeap& other);
+	BinomialHeap& operator=(BinomialHeap&& other) noexcept;
 	~BinomialHeap();
-	void insert(B value);
-	B getMin();
+	Handle insert(const B& value);
+	Handle insert(B&& value);
+	// Constructs the key in place inside its node
+	template <typename... Args>
+	Handle emplace(Args&&... args) {
+		return insertNode(createNode(std::in_place, std::forward<Args>(args)...));
+	}
+	// Builds the new elements into trees like a binary counter (O(N) links in
+	// total), then adds them to the root array once
+	template <typename Iterator>
+	void insertRange(Iterator first, Iterator last);
+	const B& getMin();
+	void setInsertMode(InsertMode mode);
+	InsertMode getInsertMode() const { return insertMode; }
+	void setSiftMode(SiftMode mode) { siftMode = mode; }
+	SiftMode getSiftMode() const { return siftMode; }
+	void consolidate();
 	
 	B extractMin();
-	void deleteKey(B value);
+	// Moves the k smallest keys (all of them if k >= size()) to out in
+	// ascending order; same cost as k extractMin calls
+	template <typename OutputIt>
+	OutputIt extractMinBatch(std::size_t k, OutputIt out) {
+		return extractBatch(k, out, [](BinomialNode<B>*) {});
+	}
+	// Moves every key to out in ascending order, leaving the heap empty
+	template <typename OutputIt>
+	OutputIt drainSorted(OutputIt out) {
+		return extractBatch(count, out, [](BinomialNode<B>*) {});
+	}
+	void deleteKey(const B& value);
+	void erase(Handle handle);
 	
-	void decreaseKey(B value, B newValue);
-	BinomialNode<B>* findKey(B value);
-	int size();
-	bool isEmpty();
+	void decreaseKey(const B& value, B newValue);
+	void decreaseKey(Handle handle, B newValue);
+	BinomialNode<B>* findKey(const B& value);
+	std::size_t size() const;
+	bool isEmpty() const;
 	void clear();
 	void DisplayNode(BinomialNode<B>* node, int depth);
-	void displayHeap(const BinomialHeap<B>* heap);
-	void testUnion(BinomialHeap<B>& other) {
-		head = unionHeap(head, other.head);
-		other.head = nullptr; // avoid double free
-	}
+	void displayHeap(const BinomialHeap<B, Compare, Allocator, Stats>* heap);
+	// O(log n) meld: moves every element of other into this heap and leaves
+	// other empty. Handles into other stay valid and now refer to this heap.
+	void merge(BinomialHeap<B, Compare, Allocator, Stats>& other);
+	void merge(BinomialHeap<B, Compare, Allocator, Stats>&& other);
+	static BinomialHeap<B, Compare, Allocator, Stats> meld(BinomialHeap<B, Compare, Allocator, Stats> a, BinomialHeap<B, Compare, Allocator, Stats> b);
+	// Melds every heap in [first, last) into one and leaves them all empty,
+	// pairing them up level by level across up to threads worker threads.
+	// Critical path O(log k * log n) for k heaps. threads = 0 picks hardware
+	// concurrency, but melds sequentially unless the inputs hold enough
+	// pending lazy-mode roots to pay for starting threads.
+	template <typename Iterator>
+	static BinomialHeap<B, Compare, Allocator, Stats> meldAll(Iterator first, Iterator last, unsigned threads = 0);
 	BinomialNode<B>* copyHeap(BinomialNode<B>* node, BinomialNode<B>* parent);
-	void duplicateAndMergeRootTree(B rootValue);
+	BinomialNode<B>* copyTree(BinomialNode<B>* root);
+	void duplicateAndMergeRootTree(const B& rootValue);
+	Handle getMinHandle() const { return minNode ? minNode->locator : nullptr; }
 	
-	// Public getter for visualization
-	BinomialNode<B>* getHead() const { return head; }
+	// Calls f(root) for every tree root: the consolidated roots by increasing
+	// order, then any roots still pending from lazy inserts. Roots are not
+	// linked through their sibling pointers.
+	template <typename F>
+	void forEachRoot(F f) const {
+		for (std::uint64_t rest = rootMask; rest != 0; rest &= rest - 1) {
+			f(roots[lowestOrder(rest)]);
+		}
+		for (BinomialNode<B>* r = pending; r != nullptr; r = r->sibling) {
+			f(r);
+		}
+	}
+	Compare getCompare() const { return this->comparator(); }
+	const Stats& getStats() const { return static_cast<const Stats&>(*this); }
+	Stats& getStats() { return static_cast<Stats&>(*this); }
 	
 protected:
-	static BinomialNode<B>* unionHeap(BinomialNode<B>* heapA, BinomialNode<B>* heapB);
-	static BinomialNode<B>* mergeHeap(BinomialNode<B>* heapA, BinomialNode<B>* heapB);
+	bool less(const B& a, const B& b) {
+		static_cast<Stats&>(*this).onCompare();
+		return this->comparator()(a, b);
+	}
 	static int order(BinomialNode<B>* heap);
+	BinomialNode<B>* linkTrees(BinomialNode<B>* a, BinomialNode<B>* b);
+	// Adds tree to the order-indexed trees like a carry in binary addition,
+	// keeping bit k of occupied set exactly when trees[k] is in use
+	void carryTree(BinomialNode<B>** trees, std::uint64_t& occupied, BinomialNode<B>* tree);
+	// carryTree into this heap's roots, keeping the root-key cache in step
+	void carryRoot(BinomialNode<B>* tree);
+	static int lowestOrder(std::uint64_t occupied);
+	static int treeCount(std::uint64_t occupied);
+	// Every write to roots goes through these so rootKeys mirrors the root keys
+	void setRoot(int k, BinomialNode<B>* tree);
+	void clearRoot(int k);
+	void syncRootKey(BinomialNode<B>* node);
+	// Slot holding the smallest root of the array; rootMask must not be 0
+	int minRootSlot();
+	// Binary addition of the trees in other (bit k of mask set for other[k]) into roots
+	void addRoots(BinomialNode<B>** other, std::uint64_t mask);
+	void consolidateRoots(BinomialNode<B>* extra);
+	BinomialNode<B>* copyRootTree(const B& rootValue);
+	void mergeTree(BinomialNode<B>* tree);
+	static void swapEntries(BinomialNode<B>* a, BinomialNode<B>* b);
+	void swapWithParent(BinomialNode<B>* node);
+	BinomialNode<B>* siftUp(BinomialNode<B>* node, bool toRoot);
+	void removeRoot(BinomialNode<B>* root);
+	// extractMinBatch with onRemove(node) called before each node's key is moved out
+	template <typename OutputIt, typename OnRemove>
+	OutputIt extractBatch(std::size_t k, OutputIt out, OnRemove onRemove);
+	void updateMin();
+	void liftMin();
+	Handle insertNode(BinomialNode<B>* newNode);
+	template <typename... Args>
+	BinomialNode<B>* createNode(Args&&... args) {
+		static_cast<Stats&>(*this).onAllocate();
+		BinomialNode<B>* node = alloc.template create<BinomialNode<B>>(std::forward<Args>(args)...);
+		node->locator = alloc.template create<BinomialLocator<B>>(node);
+		return node;
+	}
+	void destroyNode(BinomialNode<B>* node);
+	void destroyTree(BinomialNode<B>* node);
 
 
 private:
 
-	BinomialNode<B>* head;
+	// The scalars come first so they share a cache line with the low-order slots
+	std::uint64_t rootMask;     // bit k set exactly when roots[k] is in use
+	BinomialNode<B>* pending;   // lazy-mode roots not yet carried into roots, via sibling
+	BinomialNode<B>* minNode;   // root holding the smallest key, nullptr when empty
+	std::size_t count;
+	InsertMode insertMode;
+	SiftMode siftMode;
+	BinomialNode<B>* roots[64]; // roots[k] is the root of order k, nullptr if none
+	RootKeyCache<B, SimdRootScan<B, Compare>::value> rootKeys; // empty unless the keys are scanned with SIMD
+	Allocator alloc;
 };
 
 template <typename B>
 class BinomialNode
 {
 public:
-	friend class BinomialHeap<B>;
+	template <typename, typename, typename, typename> friend class BinomialHeap;
 	BinomialNode(B v, BinomialNode<B>* p = nullptr);
-	void deleteNode(BinomialNode<B>* node);
+	template <typename... Args>
+	explicit BinomialNode(std::in_place_t, Args&&... args)
+		: value(std::forward<Args>(args)...), sibling(nullptr), child(nullptr), parent(nullptr), order(0), locator(nullptr) {}
 	void addChild(BinomialNode<B>* child);
-	BinomialNode<B>* find(B v);
+	BinomialNode<B>* find(const B& v);
 	
 	// Public getters for visualization
-	B getValue() const { return value; }
+	const B& getValue() const { return value; }
 	BinomialNode<B>* getSibling() const { return sibling; }
 	BinomialNode<B>* getChild() const { return child; }
 	BinomialNode<B>* getParent() const { return parent; }
 	int getOrder() const { return order; }
+	BinomialLocator<B>* getLocator() const { return locator; }
 
 private:
 	B value;
 	BinomialNode<B>* sibling, * child, * parent;
 	int order;
+	BinomialLocator<B>* locator;
 
 };
+
+template <typename B>
+class BinomialLocator
+{
+public:
+	template <typename, typename, typename, typename> friend class BinomialHeap;
+	explicit BinomialLocator(BinomialNode<B>* n) : node(n) {}
+
+	const B& getValue() const { return node->getValue(); }
+	BinomialNode<B>* getNode() const { return node; }
+
+private:
+	BinomialNode<B>* node;
+};
+
+#include "binomial_heap_implementation.ipp"
+
 #endif /* BINOMIALHEAP_H_ */
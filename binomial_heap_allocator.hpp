@@ -0,0 +1,181 @@
+#ifndef BINOMIALHEAPALLOCATOR_H_
+#define BINOMIALHEAPALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+template <typename B>
+class BinomialNode;
+
+template <typename B>
+class BinomialLocator;
+
+// Allocator policies for BinomialHeap. A policy hands out nodes and locators
+// through create<T>(args...) / destroy<T>(ptr), and may release everything it
+// ever handed out in one step with releaseAll() (without running destructors).
+// adopt() takes over the storage of another instance when two heaps are merged.
+// Adopting into an instance that holds no storage (fresh or after releaseAll())
+// must not throw: BinomialHeap's noexcept moves rely on it.
+
+// Default policy: one new/delete per node, exactly like the original heap.
+template <typename B>
+class NewDeleteNodeAllocator
+{
+public:
+	static constexpr bool releasesInBulk = false;
+
+	template <typename T, typename... Args>
+	T* create(Args&&... args) { return new T(std::forward<Args>(args)...); }
+
+	template <typename T>
+	void destroy(T* p) { delete p; }
+
+	void releaseAll() {}
+	void adopt(NewDeleteNodeAllocator<B>&) {}
+};
+
+// Fixed-size slot arena for a single type. Slots are carved out of slabs that
+// double in size (up to MAX_SLAB_SLOTS); freed slots go on an intrusive free
+// list and are handed out again before the current slab is bumped.
+template <typename T>
+class NodePool
+{
+public:
+	static constexpr std::size_t FIRST_SLAB_SLOTS = 64;
+	static constexpr std::size_t MAX_SLAB_SLOTS = 1 << 16;
+
+	NodePool() : freeList(nullptr), freeTail(nullptr), bumpCur(nullptr), bumpEnd(nullptr), nextSlabSlots(FIRST_SLAB_SLOTS) {}
+	NodePool(const NodePool&) = delete;
+	NodePool& operator=(const NodePool&) = delete;
+	~NodePool() { releaseAll(); }
+
+	template <typename... Args>
+	T* create(Args&&... args) {
+		Slot* slot = freeList;
+		if (slot != nullptr) {
+			freeList = slot->next;
+		}
+		else {
+			if (bumpCur == bumpEnd) {
+				grow();
+			}
+			slot = bumpCur++;
+		}
+		return new (slot->storage) T(std::forward<Args>(args)...);
+	}
+
+	void destroy(T* p) {
+		p->~T();
+		Slot* slot = reinterpret_cast<Slot*>(p);
+		slot->next = freeList;
+		if (freeList == nullptr) {
+			freeTail = slot;
+		}
+		freeList = slot;
+	}
+
+	// Drops every slab at once. Objects still living in them are not destroyed.
+	void releaseAll() {
+		for (Slot* slab : slabs) {
+			::operator delete(slab);
+		}
+		slabs.clear();
+		freeList = freeTail = nullptr;
+		bumpCur = bumpEnd = nullptr;
+		nextSlabSlots = FIRST_SLAB_SLOTS;
+	}
+
+	// Takes ownership of other's slabs and free slots; other is left empty.
+	// Only appending to slabs we already own can throw.
+	void adopt(NodePool<T>& other) {
+		if (&other == this) return;
+		if (slabs.empty()) {
+			// Nothing of our own yet: take other's state as is, bump tail included
+			slabs.swap(other.slabs);
+			freeList = other.freeList;
+			freeTail = other.freeTail;
+			bumpCur = other.bumpCur;
+			bumpEnd = other.bumpEnd;
+			nextSlabSlots = other.nextSlabSlots;
+			other.freeList = other.freeTail = nullptr;
+			other.bumpCur = other.bumpEnd = nullptr;
+			other.nextSlabSlots = FIRST_SLAB_SLOTS;
+			return;
+		}
+		slabs.insert(slabs.end(), other.slabs.begin(), other.slabs.end());
+		if (other.freeList != nullptr) {
+			other.freeTail->next = freeList;
+			if (freeList == nullptr) {
+				freeTail = other.freeTail;
+			}
+			freeList = other.freeList;
+		}
+		// The unused tail of other's current slab stays owned by its slab
+		other.slabs.clear();
+		other.freeList = other.freeTail = nullptr;
+		other.bumpCur = other.bumpEnd = nullptr;
+		other.nextSlabSlots = FIRST_SLAB_SLOTS;
+	}
+
+private:
+	union Slot {
+		Slot* next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	void grow() {
+		Slot* slab = static_cast<Slot*>(::operator new(nextSlabSlots * sizeof(Slot)));
+		slabs.push_back(slab);
+		bumpCur = slab;
+		bumpEnd = slab + nextSlabSlots;
+		if (nextSlabSlots < MAX_SLAB_SLOTS) {
+			nextSlabSlots *= 2;
+		}
+	}
+
+	std::vector<Slot*> slabs;
+	Slot* freeList, * freeTail;
+	Slot* bumpCur, * bumpEnd;
+	std::size_t nextSlabSlots;
+};
+
+// Arena policy: nodes and locators come from per-heap slabs, so inserts avoid
+// the general-purpose allocator and clear() can drop the whole arena at once.
+template <typename B>
+class PoolNodeAllocator
+{
+public:
+	static constexpr bool releasesInBulk = true;
+
+	PoolNodeAllocator() {}
+	// Arenas are never shared; a copied heap starts with its own empty arena
+	PoolNodeAllocator(const PoolNodeAllocator&) {}
+	PoolNodeAllocator& operator=(const PoolNodeAllocator&) { return *this; }
+
+	template <typename T, typename... Args>
+	T* create(Args&&... args) { return poolFor(static_cast<T*>(nullptr)).create(std::forward<Args>(args)...); }
+
+	template <typename T>
+	void destroy(T* p) { poolFor(p).destroy(p); }
+
+	void releaseAll() {
+		nodes.releaseAll();
+		locators.releaseAll();
+	}
+
+	void adopt(PoolNodeAllocator<B>& other) {
+		nodes.adopt(other.nodes);
+		locators.adopt(other.locators);
+	}
+
+private:
+	NodePool<BinomialNode<B>>& poolFor(BinomialNode<B>*) { return nodes; }
+	NodePool<BinomialLocator<B>>& poolFor(BinomialLocator<B>*) { return locators; }
+
+	NodePool<BinomialNode<B>> nodes;
+	NodePool<BinomialLocator<B>> locators;
+};
+
+#endif /* BINOMIALHEAPALLOCATOR_H_ */
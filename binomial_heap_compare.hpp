@@ -0,0 +1,38 @@
+#ifndef BINOMIALHEAPCOMPARE_H_
+#define BINOMIALHEAPCOMPARE_H_
+
+#include <type_traits>
+#include <utility>
+
+// Holds the comparator of a heap. A non-final class type (std::less, a
+// functor, a lambda) becomes a private base, so stateless comparators take
+// no space. Anything that cannot be a base, such as a function pointer
+// bool (*)(const B&, const B&) or a final class, is kept as a member.
+template <typename Compare, bool AsBase = std::is_class<Compare>::value && !std::is_final<Compare>::value>
+class CompareHolder : private Compare
+{
+public:
+	CompareHolder() {}
+	explicit CompareHolder(const Compare& comp) : Compare(comp) {}
+	explicit CompareHolder(Compare&& comp) : Compare(std::move(comp)) {}
+
+	const Compare& comparator() const { return *this; }
+	Compare& comparator() { return *this; }
+};
+
+template <typename Compare>
+class CompareHolder<Compare, false>
+{
+public:
+	CompareHolder() : comp() {}
+	explicit CompareHolder(const Compare& comp) : comp(comp) {}
+	explicit CompareHolder(Compare&& comp) : comp(std::move(comp)) {}
+
+	const Compare& comparator() const { return comp; }
+	Compare& comparator() { return comp; }
+
+private:
+	Compare comp;
+};
+
+#endif /* BINOMIALHEAPCOMPARE_H_ */
@@ -0,0 +1,857 @@
+// Template definitions for binomial_heap.hpp. Included at the end of that
+// header so BinomialHeap works with any key type that has a strict weak
+// ordering; do not include this file directly.
+
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>::BinomialHeap() : rootMask(0), pending(nullptr), roots() {
+	minNode = nullptr;
+	count = 0;
+	insertMode = EAGER;
+	siftMode = SWAP_KEYS;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>::BinomialHeap(const Compare& comp) : CompareBase(comp), rootMask(0), pending(nullptr), roots() {
+	minNode = nullptr;
+	count = 0;
+	insertMode = EAGER;
+	siftMode = SWAP_KEYS;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+template <typename Iterator>
+BinomialHeap<B, Compare, Allocator, Stats>::BinomialHeap(Iterator first, Iterator last, const Compare& comp) : BinomialHeap(comp) {
+	insertRange(first, last);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>::BinomialHeap(const BinomialHeap<B, Compare, Allocator, Stats>& other) : CompareBase(other.comparator()), rootMask(0), pending(nullptr), minNode(nullptr), count(0), insertMode(EAGER), siftMode(SWAP_KEYS), roots() {
+	*this = other;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>::BinomialHeap(BinomialHeap<B, Compare, Allocator, Stats>&& other) noexcept
+	: CompareBase(std::move(other.comparator())), rootMask(0), pending(other.pending),
+	  minNode(other.minNode), count(other.count), insertMode(other.insertMode), siftMode(other.siftMode), roots() {
+	alloc.adopt(other.alloc); // alloc holds no storage yet, so this cannot throw
+	for (std::uint64_t rest = other.rootMask; rest != 0; rest &= rest - 1) {
+		int k = lowestOrder(rest);
+		setRoot(k, other.roots[k]);
+		other.clearRoot(k);
+	}
+	other.pending = nullptr;
+	other.minNode = nullptr;
+	other.count = 0;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>& BinomialHeap<B, Compare, Allocator, Stats>::operator=(BinomialHeap<B, Compare, Allocator, Stats>&& other) noexcept {
+	if (this != &other) {
+		clear();
+		// An empty heap can still hold pool slabs; drop them so adopt cannot throw
+		alloc.releaseAll();
+		this->comparator() = std::move(other.comparator());
+		alloc.adopt(other.alloc);
+		for (std::uint64_t rest = other.rootMask; rest != 0; rest &= rest - 1) {
+			int k = lowestOrder(rest);
+			setRoot(k, other.roots[k]);
+			other.clearRoot(k);
+		}
+		pending = other.pending;
+		minNode = other.minNode;
+		count = other.count;
+		insertMode = other.insertMode;
+		siftMode = other.siftMode;
+		other.pending = nullptr;
+		other.minNode = nullptr;
+		other.count = 0;
+	}
+	return *this;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>& BinomialHeap<B, Compare, Allocator, Stats>::operator=(const BinomialHeap<B, Compare, Allocator, Stats>& other) {
+	if (this != &other) {
+		clear();
+		this->comparator() = other.comparator();
+
+		for (std::uint64_t rest = other.rootMask; rest != 0; rest &= rest - 1) {
+			int k = lowestOrder(rest);
+			setRoot(k, copyTree(other.roots[k]));
+		}
+		BinomialNode<B>** tail = &pending;
+		for (BinomialNode<B>* r = other.pending; r != nullptr; r = r->sibling) {
+			*tail = copyTree(r);
+			tail = &(*tail)->sibling;
+		}
+		updateMin();
+		count = other.count;
+		insertMode = other.insertMode;
+		siftMode = other.siftMode;
+	}
+	return *this;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialNode<B>* BinomialHeap<B, Compare, Allocator, Stats>::copyHeap(BinomialNode<B>* node, BinomialNode<B>* parent) {
+	if (!node) return nullptr;
+
+	BinomialNode<B>* newNode = createNode(node->value, parent);
+	newNode->order = node->order;
+
+	if (node->child) {
+		newNode->child = copyHeap(node->child, newNode);
+	}
+
+	if (node->sibling) {
+		newNode->sibling = copyHeap(node->sibling, parent);
+	}
+
+	return newNode;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialNode<B>* BinomialHeap<B, Compare, Allocator, Stats>::copyTree(BinomialNode<B>* root) {
+	// Like copyHeap, but leaves out the root's siblings
+	BinomialNode<B>* newRoot = createNode(root->value, nullptr);
+	newRoot->order = root->order;
+	newRoot->child = copyHeap(root->child, newRoot);
+	return newRoot;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats>::~BinomialHeap() {
+	clear();
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+typename BinomialHeap<B, Compare, Allocator, Stats>::Handle BinomialHeap<B, Compare, Allocator, Stats>::insert(const B& value) {
+	return insertNode(createNode(value, nullptr));
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+typename BinomialHeap<B, Compare, Allocator, Stats>::Handle BinomialHeap<B, Compare, Allocator, Stats>::insert(B&& value) {
+	return insertNode(createNode(std::move(value), nullptr));
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+typename BinomialHeap<B, Compare, Allocator, Stats>::Handle BinomialHeap<B, Compare, Allocator, Stats>::insertNode(BinomialNode<B>* newNode) {
+	if (minNode == nullptr || less(newNode->value, minNode->value)) {
+		minNode = newNode;
+	}
+	if (insertMode == LAZY) {
+		newNode->sibling = pending;
+		pending = newNode;
+	}
+	else {
+		consolidate();
+		carryRoot(newNode);
+		liftMin();
+	}
+	count++;
+	return newNode->locator;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+template <typename Iterator>
+void BinomialHeap<B, Compare, Allocator, Stats>::insertRange(Iterator first, Iterator last) {
+	// trees[k] holds the pending tree of order k, like bit k of a counter
+	BinomialNode<B>* trees[64] = {};
+	std::uint64_t built = 0;
+	std::size_t added = 0;
+	try {
+		for (; first != last; ++first) {
+			carryTree(trees, built, createNode(*first, nullptr));
+			added++;
+		}
+	}
+	catch (...) {
+		// Nothing has reached the heap yet, so dropping the partial trees leaves it unchanged
+		for (std::uint64_t rest = built; rest != 0; rest &= rest - 1) {
+			destroyTree(trees[lowestOrder(rest)]);
+		}
+		throw;
+	}
+	if (added == 0) {
+		return;
+	}
+
+	if (insertMode == LAZY) {
+		for (std::uint64_t rest = built; rest != 0; rest &= rest - 1) {
+			BinomialNode<B>* tree = trees[lowestOrder(rest)];
+			tree->sibling = pending;
+			pending = tree;
+		}
+	}
+	else {
+		consolidate();
+		addRoots(trees, built);
+	}
+	count += added;
+	updateMin();
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialNode<B>* BinomialHeap<B, Compare, Allocator, Stats>::linkTrees(BinomialNode<B>* a, BinomialNode<B>* b) {
+	// On ties a stays the root
+	getStats().onLink();
+	if (!less(b->value, a->value)) {
+		a->addChild(b);
+		return a;
+	}
+	b->addChild(a);
+	return b;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::carryTree(BinomialNode<B>** trees, std::uint64_t& occupied, BinomialNode<B>* tree) {
+	tree->sibling = nullptr;
+	tree->parent = nullptr;
+	int k = tree->order;
+	while (trees[k] != nullptr) {
+		tree = linkTrees(trees[k], tree);
+		trees[k] = nullptr;
+		occupied &= ~(std::uint64_t(1) << k);
+		k++;
+	}
+	trees[k] = tree;
+	occupied |= std::uint64_t(1) << k;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::carryRoot(BinomialNode<B>* tree) {
+	tree->sibling = nullptr;
+	tree->parent = nullptr;
+	int k = tree->order;
+	while (roots[k] != nullptr) {
+		tree = linkTrees(roots[k], tree);
+		clearRoot(k);
+		k++;
+	}
+	setRoot(k, tree);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::setRoot(int k, BinomialNode<B>* tree) {
+	roots[k] = tree;
+	rootMask |= std::uint64_t(1) << k;
+	rootKeys.set(k, tree->value);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::clearRoot(int k) {
+	roots[k] = nullptr;
+	rootMask &= ~(std::uint64_t(1) << k);
+	rootKeys.reset(k);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::syncRootKey(BinomialNode<B>* node) {
+	// Pending roots are not in the array and have no cached key
+	if (node->parent == nullptr && roots[node->order] == node) {
+		rootKeys.set(node->order, node->value);
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+int BinomialHeap<B, Compare, Allocator, Stats>::minRootSlot() {
+	if constexpr (decltype(rootKeys)::enabled) {
+		// Reported as the compares of the scalar scan, so the counts match it
+		for (int n = treeCount(rootMask); n > 1; n--) {
+			getStats().onCompare();
+		}
+		return rootKeys.minSlot(rootMask);
+	}
+	else {
+		int best = lowestOrder(rootMask);
+		for (std::uint64_t rest = rootMask & (rootMask - 1); rest != 0; rest &= rest - 1) {
+			int s = lowestOrder(rest);
+			if (less(roots[s]->value, roots[best]->value)) {
+				best = s;
+			}
+		}
+		return best;
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+int BinomialHeap<B, Compare, Allocator, Stats>::lowestOrder(std::uint64_t occupied) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(occupied);
+#elif defined(_MSC_VER)
+	unsigned long k;
+	_BitScanForward64(&k, occupied);
+	return int(k);
+#else
+	int k = 0;
+	while ((occupied & 1) == 0) {
+		occupied >>= 1;
+		k++;
+	}
+	return k;
+#endif
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+int BinomialHeap<B, Compare, Allocator, Stats>::treeCount(std::uint64_t occupied) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(occupied);
+#elif defined(_MSC_VER)
+	return int(__popcnt64(occupied));
+#else
+	int n = 0;
+	for (; occupied != 0; occupied &= occupied - 1) {
+		n++;
+	}
+	return n;
+#endif
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::addRoots(BinomialNode<B>** other, std::uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	// A melded heap is usually cold; fetch all its roots at once rather than
+	// missing on each in turn as the carries reach it
+	for (std::uint64_t rest = mask; rest != 0; rest &= rest - 1) {
+		__builtin_prefetch(other[lowestOrder(rest)]);
+	}
+#endif
+	// Lowest order first, so a carry out of slot k meets other[k + 1] on its way up
+	for (; mask != 0; mask &= mask - 1) {
+		carryRoot(other[lowestOrder(mask)]);
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::consolidateRoots(BinomialNode<B>* extra) {
+	// Carries the pending list and the trees chained from extra into roots
+	BinomialNode<B>* lists[2] = { pending, extra };
+	std::size_t visited = 0;
+	for (BinomialNode<B>* curr : lists) {
+		while (curr != nullptr) {
+			BinomialNode<B>* next = curr->sibling;
+			carryRoot(curr);
+			curr = next;
+			visited++;
+		}
+	}
+	getStats().onRootScan(visited);
+	pending = nullptr;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::consolidate() {
+	if (pending == nullptr) {
+		return;
+	}
+	consolidateRoots(nullptr);
+	liftMin();
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::setInsertMode(InsertMode mode) {
+	insertMode = mode;
+	if (mode == EAGER) {
+		consolidate();
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::merge(BinomialHeap<B, Compare, Allocator, Stats>& other) {
+	if (this == &other || other.count == 0) {
+		return;
+	}
+	consolidate();
+	other.consolidate();
+	alloc.adopt(other.alloc);
+	if (minNode == nullptr || less(other.minNode->value, minNode->value)) {
+		minNode = other.minNode;
+	}
+	addRoots(other.roots, other.rootMask);
+	liftMin();
+	count += other.count;
+
+	// Nodes now belong to this heap. Only the used slots are cleared: the
+	// array spans eight cache lines and a meld otherwise touches two or three.
+	for (std::uint64_t rest = other.rootMask; rest != 0; rest &= rest - 1) {
+		other.clearRoot(lowestOrder(rest));
+	}
+	other.minNode = nullptr;
+	other.count = 0;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::merge(BinomialHeap<B, Compare, Allocator, Stats>&& other) {
+	merge(other);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialHeap<B, Compare, Allocator, Stats> BinomialHeap<B, Compare, Allocator, Stats>::meld(BinomialHeap<B, Compare, Allocator, Stats> a, BinomialHeap<B, Compare, Allocator, Stats> b) {
+	a.merge(b);
+	return a;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+template <typename Iterator>
+BinomialHeap<B, Compare, Allocator, Stats> BinomialHeap<B, Compare, Allocator, Stats>::meldAll(Iterator first, Iterator last, unsigned threads) {
+	std::vector<BinomialHeap<B, Compare, Allocator, Stats>*> heaps;
+	for (; first != last; ++first) {
+		heaps.push_back(&*first);
+	}
+	if (heaps.empty()) {
+		return BinomialHeap<B, Compare, Allocator, Stats>();
+	}
+	if (threads == 0) {
+		// Melding consolidated heaps is O(log n) each, far below the cost of
+		// starting a thread; only carrying pending roots is worth splitting,
+		// and only when there are enough of them (about 16K carries, which
+		// takes roughly as long as spawning a worker). The count stops at
+		// the threshold, since walking a long pending list is itself slow.
+		const std::size_t parallelRoots = std::size_t(1) << 14;
+		std::size_t pendingRoots = 0;
+		for (std::size_t i = 0; i < heaps.size() && pendingRoots < parallelRoots; i++) {
+			for (BinomialNode<B>* r = heaps[i]->pending; r != nullptr && pendingRoots < parallelRoots; r = r->sibling) {
+				pendingRoots++;
+			}
+		}
+		threads = pendingRoots < parallelRoots ? 1 : std::thread::hardware_concurrency();
+	}
+	std::size_t workers = std::min<std::size_t>(threads ? threads : 1, heaps.size() / 2);
+	if (workers <= 1) {
+		for (std::size_t i = 1; i < heaps.size(); i++) {
+			heaps[0]->merge(*heaps[i]);
+		}
+		return std::move(*heaps[0]);
+	}
+
+	// Level L melds slot a = i * 2^(L+1) with slot a + 2^L. Tasks are numbered
+	// level by level and claimed in that order, so a task only ever waits for
+	// lower-numbered tasks that are already running; done[a] counts the levels
+	// slot a has finished (a missing partner still counts as a finished level).
+	std::size_t k = heaps.size();
+	std::vector<std::size_t> levelStart(1, 0);
+	for (std::size_t span = 1; span < k; span *= 2) {
+		levelStart.push_back(levelStart.back() + (k + 2 * span - 1) / (2 * span));
+	}
+	std::size_t tasks = levelStart.back();
+	std::vector<std::atomic<unsigned>> done(k);
+	for (std::atomic<unsigned>& d : done) {
+		d.store(0, std::memory_order_relaxed);
+	}
+	std::atomic<std::size_t> next(0);
+
+	auto work = [&]() {
+		unsigned level = 0;
+		for (std::size_t t = next.fetch_add(1); t < tasks; t = next.fetch_add(1)) {
+			while (t >= levelStart[level + 1]) {
+				level++;
+			}
+			std::size_t span = std::size_t(1) << level;
+			std::size_t a = (t - levelStart[level]) * 2 * span;
+			std::size_t b = a + span;
+			while (done[a].load(std::memory_order_acquire) < level
+				|| (b < k && done[b].load(std::memory_order_acquire) < level)) {
+				std::this_thread::yield();
+			}
+			if (b < k) {
+				heaps[a]->merge(*heaps[b]);
+			}
+			done[a].store(level + 1, std::memory_order_release);
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (std::size_t i = 1; i < workers; i++) {
+		pool.emplace_back(work);
+	}
+	work();
+	for (std::thread& t : pool) {
+		t.join();
+	}
+	return std::move(*heaps[0]);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+const B& BinomialHeap<B, Compare, Allocator, Stats>::getMin() {
+	if (count == 0) {
+		throw std::runtime_error("Cannot get min from empty heap");
+	}
+	return minNode->value;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+B BinomialHeap<B, Compare, Allocator, Stats>::extractMin() {
+	if (count == 0) {
+		throw std::runtime_error("Cannot extract min from empty heap");
+	}
+	B minVal = std::move(minNode->value);
+	removeRoot(minNode);
+	return minVal;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+template <typename OutputIt, typename OnRemove>
+OutputIt BinomialHeap<B, Compare, Allocator, Stats>::extractBatch(std::size_t k, OutputIt out, OnRemove onRemove) {
+	if (k > count) {
+		k = count;
+	}
+	if (k == 0) {
+		return out;
+	}
+	// Not a fast path: every key goes through the same removeRoot as
+	// extractMin. Taking the k smallest as a top-closed set from a frontier
+	// heap and carrying the orphaned children once was tried and measured
+	// slower, since it reads every child of every taken node anyway and then
+	// revisits the orphans. A node is removed only after its key reached out,
+	// so if onRemove or out throws the heap keeps that element.
+	for (std::size_t i = 0; i < k; i++) {
+		BinomialNode<B>* node = minNode;
+		onRemove(node);
+		*out = std::move(node->value);
+		++out;
+		removeRoot(node);
+	}
+	return out;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::updateMin() {
+	minNode = rootMask != 0 ? roots[minRootSlot()] : nullptr;
+	std::size_t visited = treeCount(rootMask);
+	for (BinomialNode<B>* root = pending; root != nullptr; root = root->sibling) {
+		if (minNode == nullptr || less(root->value, minNode->value)) {
+			minNode = root;
+		}
+		visited++;
+	}
+	getStats().onRootScan(visited);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::liftMin() {
+	// A carry may link the min root under a root holding an equal key;
+	// that ancestor is then the min root.
+	if (minNode == nullptr) return;
+	while (minNode->parent != nullptr) {
+		minNode = minNode->parent;
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::removeRoot(BinomialNode<B>* root) {
+	if (roots[root->order] == root) {
+		clearRoot(root->order);
+	}
+	else {
+		// A root not yet consolidated; unlink it from the pending list
+		BinomialNode<B>** link = &pending;
+		while (*link != root) {
+			link = &(*link)->sibling;
+		}
+		*link = root->sibling;
+	}
+	// One pass carries the children and every pending root into the array.
+	// The children have orders root->order - 1 down to 0, so this is a binary
+	// addition on rootMask.
+	consolidateRoots(root->child);
+	destroyNode(root);
+	count--;
+	updateMin();
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::deleteKey(const B& value) {
+	BinomialNode<B>* node = findKey(value);
+	if (!node) {
+		throw std::runtime_error("Value not found in heap");
+	}
+	// Detach the node directly; no sentinel key, so no underflow at the minimum
+	erase(node->locator);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::erase(Handle handle) {
+	if (!handle) {
+		throw std::runtime_error("Invalid handle");
+	}
+	// Bubble the node all the way up regardless of keys, then drop its root
+	removeRoot(siftUp(handle->node, true));
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::decreaseKey(const B& value, B newValue) {
+	BinomialNode<B>* node = findKey(value);
+
+	if (!node) {
+		throw std::runtime_error("Key not found in heap");
+	}
+
+	decreaseKey(node->locator, std::move(newValue));
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::decreaseKey(Handle handle, B newValue) {
+	if (!handle) {
+		throw std::runtime_error("Invalid handle");
+	}
+	BinomialNode<B>* node = handle->node;
+
+	if (!less(newValue, node->value)) {
+		throw std::runtime_error("New value must be smaller than current value");
+	}
+
+	node->value = std::move(newValue);
+	BinomialNode<B>* top = siftUp(node, false);
+	syncRootKey(top);
+	if (top->parent == nullptr && less(top->value, minNode->value)) {
+		minNode = top;
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::swapEntries(BinomialNode<B>* a, BinomialNode<B>* b) {
+	std::swap(a->value, b->value);
+
+	// Locators follow their keys so handles keep pointing at the same element
+	BinomialLocator<B>* loc = a->locator;
+	a->locator = b->locator;
+	b->locator = loc;
+	a->locator->node = a;
+	b->locator->node = b;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialNode<B>* BinomialHeap<B, Compare, Allocator, Stats>::siftUp(BinomialNode<B>* node, bool toRoot) {
+	BinomialNode<B>* current = node;
+	BinomialNode<B>* parent = current->parent;
+
+	if (siftMode == RELINK_NODES) {
+		// The node itself climbs; its key and locator never move
+		while (parent && (toRoot || less(current->value, parent->value))) {
+			getStats().onSiftStep();
+			swapWithParent(current);
+			parent = current->parent;
+		}
+		return current;
+	}
+
+	while (parent && (toRoot || less(current->value, parent->value))) {
+		getStats().onSiftStep();
+		swapEntries(current, parent);
+
+		current = parent;
+		parent = current->parent;
+	}
+	return current;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::swapWithParent(BinomialNode<B>* node) {
+	BinomialNode<B>* parent = node->parent;
+	BinomialNode<B>* grand = parent->parent;
+
+	// Find the links pointing at node (in parent's child list) and at parent
+	// (in grand's child list, the root array or the pending list)
+	BinomialNode<B>* nodePrev = nullptr;
+	for (BinomialNode<B>* c = parent->child; c != node; c = c->sibling) {
+		nodePrev = c;
+	}
+	bool parentInArray = grand == nullptr && roots[parent->order] == parent;
+	BinomialNode<B>* parentPrev = nullptr;
+	if (!parentInArray) {
+		for (BinomialNode<B>* c = grand ? grand->child : pending; c != parent; c = c->sibling) {
+			parentPrev = c;
+		}
+	}
+
+	BinomialNode<B>* nodeChild = node->child;
+	BinomialNode<B>* nodeSibling = node->sibling;
+	int nodeOrder = node->order;
+
+	// node takes parent's slot
+	if (parentPrev != nullptr) {
+		parentPrev->sibling = node;
+	}
+	else if (grand != nullptr) {
+		grand->child = node;
+	}
+	else if (parentInArray) {
+		setRoot(parent->order, node);
+	}
+	else {
+		pending = node;
+	}
+	node->parent = grand;
+	node->sibling = parent->sibling;
+	node->order = parent->order;
+
+	// node inherits parent's children, with parent in its own old position
+	if (nodePrev != nullptr) {
+		node->child = parent->child;
+		nodePrev->sibling = parent;
+	}
+	else {
+		node->child = parent;
+	}
+	parent->sibling = nodeSibling;
+
+	// parent takes node's old children
+	parent->child = nodeChild;
+	parent->order = nodeOrder;
+
+	for (BinomialNode<B>* c = node->child; c != nullptr; c = c->sibling) {
+		c->parent = node;
+	}
+	for (BinomialNode<B>* c = parent->child; c != nullptr; c = c->sibling) {
+		c->parent = parent;
+	}
+	if (minNode == parent) {
+		minNode = node;
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialNode<B>* BinomialHeap<B, Compare, Allocator, Stats>::findKey(const B& value) {
+	for (std::uint64_t rest = rootMask; rest != 0; rest &= rest - 1) {
+		BinomialNode<B>* foundNode = roots[lowestOrder(rest)]->find(value);
+
+		if (foundNode) {
+			return foundNode;
+		}
+	}
+	for (BinomialNode<B>* currentRoot = pending; currentRoot; currentRoot = currentRoot->sibling) {
+		BinomialNode<B>* foundNode = currentRoot->find(value);
+
+		if (foundNode) {
+			return foundNode;
+		}
+	}
+	return nullptr;
+}
+template <typename T>
+BinomialNode<T>* BinomialNode<T>::find(const T& v) {
+	if (value == v) {
+		return this;
+	}
+	BinomialNode<T>* childPtr = child;
+	while (childPtr) {
+		// Recursively search this child's entire subtree
+		BinomialNode<T>* found = childPtr->find(v);
+
+		if (found) {
+			return found;
+		}
+		childPtr = childPtr->sibling;
+	}
+	return nullptr;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+std::size_t BinomialHeap<B, Compare, Allocator, Stats>::size() const {
+	return count;
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+bool BinomialHeap<B, Compare, Allocator, Stats>::isEmpty() const {
+	return(count == 0);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::destroyNode(BinomialNode<B>* node) {
+	getStats().onDeallocate(1);
+	alloc.destroy(node->locator);
+	alloc.destroy(node);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::destroyTree(BinomialNode<B>* node) {
+	BinomialNode<B>* c = node->child;
+	while (c != nullptr) {
+		BinomialNode<B>* next = c->sibling;
+		destroyTree(c);
+		c = next;
+	}
+	destroyNode(node);
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::clear() {
+	if (isEmpty()) {
+		return;
+	}
+	else if (Allocator::releasesInBulk && std::is_trivially_destructible<B>::value) {
+		// Nothing to run per node, so the arena can simply be dropped
+		getStats().onDeallocate(count);
+		alloc.releaseAll();
+	}
+	else {
+		for (std::uint64_t rest = rootMask; rest != 0; rest &= rest - 1) {
+			destroyTree(roots[lowestOrder(rest)]);
+		}
+		BinomialNode<B>* curr = pending;
+		while (curr != nullptr) {
+			BinomialNode<B>* next = curr->sibling;
+			destroyTree(curr);
+			curr = next;
+
+		}
+		alloc.releaseAll();
+	}
+	for (std::uint64_t rest = rootMask; rest != 0; rest &= rest - 1) {
+		clearRoot(lowestOrder(rest));
+	}
+	pending = nullptr;
+	minNode = nullptr;
+	count = 0;
+}
+
+template <typename B, typename Compare, typename Allocator, typename Stats>
+int BinomialHeap<B, Compare, Allocator, Stats>::order(BinomialNode<B>* heap) {
+	if (heap == nullptr)
+		return -1;
+
+	int i = 0;
+	BinomialNode<B>* temp = heap->child;
+
+	while (temp != nullptr) {
+		i++;
+		temp = temp->sibling;
+	}
+
+	return i;
+}
+
+
+// Binomial Node
+
+template <typename B>
+BinomialNode<B>::BinomialNode(B v, BinomialNode<B>* p): value(std::move(v)),sibling(nullptr),child(nullptr),parent(p),order(0),locator(nullptr) {
+}
+
+template <typename B>
+void BinomialNode<B>::addChild(BinomialNode<B>* c) {
+	// Heap order is the caller's job: only BinomialHeap knows the comparator
+	if (c != nullptr) {
+		if (child == nullptr) {
+			
+			child = c;
+		}
+		else {
+			c->sibling = child;
+			child = c;
+		}
+		c->parent = this;
+		order++;
+	}
+
+
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::DisplayNode(BinomialNode<B>* node, int depth) {
+	for (int i = 0; i < depth; i++) {
+		std::cout << "  ";
+	}
+	std::cout << node->value << std::endl;
+	BinomialNode<B>* child = node->child;
+	while (child != nullptr) {
+		DisplayNode(child, depth + 1);
+		child = child->sibling;
+	}
+}
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::displayHeap(const BinomialHeap<B, Compare, Allocator, Stats>* heap) {
+	if (heap->count == 0) {
+		std::cout << "Heap is empty!" << std::endl;
+		return;
+	}
+	heap->forEachRoot([this](BinomialNode<B>* curr) {
+		std::cout << "B" << curr->order << std::endl;
+		DisplayNode(curr, 0);
+	});
+	std::cout << "Size of heap: " << size()<< std::endl;
+}
+
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::duplicateAndMergeRootTree(const B& rootValue) {
+	mergeTree(copyRootTree(rootValue));
+}
+
+template <typename B, typename Compare, typename Allocator, typename Stats>
+BinomialNode<B>* BinomialHeap<B, Compare, Allocator, Stats>::copyRootTree(const B& rootValue) {
+	// Find the root node with the given value
+	BinomialNode<B>* targetRoot = nullptr;
+	forEachRoot([&](BinomialNode<B>* root) {
+		if (!targetRoot && root->value == rootValue) {
+			targetRoot = root;
+		}
+	});
+	
+	if (!targetRoot) {
+		throw std::runtime_error("Root node with specified value not found");
+	}
+	
+	// Create a standalone copy (not connected to any other roots)
+	return copyTree(targetRoot);
+}
+
+template <typename B, typename Compare, typename Allocator, typename Stats>
+void BinomialHeap<B, Compare, Allocator, Stats>::mergeTree(BinomialNode<B>* tree) {
+	std::size_t treeSize = std::size_t(1) << tree->order;
+
+	// Carry the copied tree into the root array
+	consolidate();
+	carryRoot(tree);
+	liftMin();
+	count += treeSize;
+}
@@ -0,0 +1,273 @@
+#ifndef BINOMIALHEAPSIMD_H_
+#define BINOMIALHEAPSIMD_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Root-key cache for BinomialHeap's minimum scan. For plain arithmetic keys
+// ordered by std::less the heap keeps a copy of each root's key in a
+// contiguous array indexed by order, so finding the smallest root is a few
+// vector compares over that array instead of a pointer chase per root. The
+// vector width is picked at compile time (AVX2, then SSE, then scalar code on
+// other targets); every other key type or comparator gets an empty cache and
+// the heap keeps comparing through Compare.
+
+// True for int32/int64/float/double keys compared with std::less
+template <typename B, typename Compare>
+struct SimdRootScan : std::integral_constant<bool,
+	(std::is_same<Compare, std::less<B>>::value || std::is_same<Compare, std::less<>>::value)
+	&& ((std::is_integral<B>::value && std::is_signed<B>::value && (sizeof(B) == 4 || sizeof(B) == 8))
+		|| std::is_same<B, float>::value || std::is_same<B, double>::value)> {};
+
+enum RootKeyKind {
+	ROOT_KEY_I32,
+	ROOT_KEY_I64,
+	ROOT_KEY_F32,
+	ROOT_KEY_F64
+};
+
+template <typename B>
+struct RootKeyKindOf : std::integral_constant<int,
+	std::is_floating_point<B>::value ? (sizeof(B) == 4 ? ROOT_KEY_F32 : ROOT_KEY_F64)
+		: (sizeof(B) == 4 ? ROOT_KEY_I32 : ROOT_KEY_I64)> {};
+
+// Vector operations on width keys of one kind: aligned load/store, lane-wise
+// min, broadcast, and eq(a, b) with bit i set when lane i of a equals lane i of
+// b. The primary template (width 1) means there is no vector path for the kind.
+template <int Kind>
+struct RootLanes
+{
+	static const int width = 1;
+};
+
+#if defined(__AVX2__)
+
+template <>
+struct RootLanes<ROOT_KEY_I32>
+{
+	typedef std::int32_t T;
+	typedef __m256i V;
+	static const int width = 8;
+	static V load(const void* p) { return _mm256_load_si256(static_cast<const __m256i*>(p)); }
+	static void store(T* p, V v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+	static V min(V a, V b) { return _mm256_min_epi32(a, b); }
+	static V splat(T x) { return _mm256_set1_epi32(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+};
+
+template <>
+struct RootLanes<ROOT_KEY_I64>
+{
+	typedef long long T;
+	typedef __m256i V;
+	static const int width = 4;
+	static V load(const void* p) { return _mm256_load_si256(static_cast<const __m256i*>(p)); }
+	static void store(T* p, V v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+	// No 64-bit integer min before AVX-512, so select through a compare
+	static V min(V a, V b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+	static V splat(T x) { return _mm256_set1_epi64x(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+};
+
+template <>
+struct RootLanes<ROOT_KEY_F32>
+{
+	typedef float T;
+	typedef __m256 V;
+	static const int width = 8;
+	static V load(const void* p) { return _mm256_load_ps(static_cast<const float*>(p)); }
+	static void store(T* p, V v) { _mm256_store_ps(p, v); }
+	static V min(V a, V b) { return _mm256_min_ps(a, b); }
+	static V splat(T x) { return _mm256_set1_ps(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+};
+
+template <>
+struct RootLanes<ROOT_KEY_F64>
+{
+	typedef double T;
+	typedef __m256d V;
+	static const int width = 4;
+	static V load(const void* p) { return _mm256_load_pd(static_cast<const double*>(p)); }
+	static void store(T* p, V v) { _mm256_store_pd(p, v); }
+	static V min(V a, V b) { return _mm256_min_pd(a, b); }
+	static V splat(T x) { return _mm256_set1_pd(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+};
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+template <>
+struct RootLanes<ROOT_KEY_I32>
+{
+	typedef std::int32_t T;
+	typedef __m128i V;
+	static const int width = 4;
+	static V load(const void* p) { return _mm_load_si128(static_cast<const __m128i*>(p)); }
+	static void store(T* p, V v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+#if defined(__SSE4_1__)
+	static V min(V a, V b) { return _mm_min_epi32(a, b); }
+#else
+	static V min(V a, V b) {
+		V lt = _mm_cmplt_epi32(a, b);
+		return _mm_or_si128(_mm_and_si128(lt, a), _mm_andnot_si128(lt, b));
+	}
+#endif
+	static V splat(T x) { return _mm_set1_epi32(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+};
+
+#if defined(__SSE4_2__)
+template <>
+struct RootLanes<ROOT_KEY_I64>
+{
+	typedef long long T;
+	typedef __m128i V;
+	static const int width = 2;
+	static V load(const void* p) { return _mm_load_si128(static_cast<const __m128i*>(p)); }
+	static void store(T* p, V v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+	static V min(V a, V b) { return _mm_blendv_epi8(a, b, _mm_cmpgt_epi64(a, b)); }
+	static V splat(T x) { return _mm_set1_epi64x(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(a, b)))); }
+};
+#endif
+
+template <>
+struct RootLanes<ROOT_KEY_F32>
+{
+	typedef float T;
+	typedef __m128 V;
+	static const int width = 4;
+	static V load(const void* p) { return _mm_load_ps(static_cast<const float*>(p)); }
+	static void store(T* p, V v) { _mm_store_ps(p, v); }
+	static V min(V a, V b) { return _mm_min_ps(a, b); }
+	static V splat(T x) { return _mm_set1_ps(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+};
+
+template <>
+struct RootLanes<ROOT_KEY_F64>
+{
+	typedef double T;
+	typedef __m128d V;
+	static const int width = 2;
+	static V load(const void* p) { return _mm_load_pd(static_cast<const double*>(p)); }
+	static void store(T* p, V v) { _mm_store_pd(p, v); }
+	static V min(V a, V b) { return _mm_min_pd(a, b); }
+	static V splat(T x) { return _mm_set1_pd(x); }
+	static unsigned eq(V a, V b) { return unsigned(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+};
+
+#endif
+
+// Disabled cache: generic keys keep the pointer-chasing scan
+template <typename B, bool Enabled>
+class RootKeyCache
+{
+public:
+	static constexpr bool enabled = false;
+	void set(int, const B&) {}
+	void reset(int) {}
+	int minSlot(std::uint64_t) const { return 0; }
+};
+
+// keys[k] mirrors the key of the order-k root. Empty slots hold the largest
+// key value, so they can be scanned along with the occupied ones.
+template <typename B>
+class RootKeyCache<B, true>
+{
+public:
+	static constexpr bool enabled = true;
+
+	RootKeyCache() { std::fill(keys, keys + 64, emptyKey()); }
+	void set(int k, const B& key) { keys[k] = key; }
+	void reset(int k) { keys[k] = emptyKey(); }
+
+	// Slot of the smallest key among the set bits of occupied (which must be
+	// nonzero). Ties go to the lowest slot, like the scalar root scan.
+	int minSlot(std::uint64_t occupied) const {
+		typedef RootLanes<RootKeyKindOf<B>::value> Lanes;
+		if constexpr (Lanes::width > 1) {
+			typedef typename Lanes::T T;
+			typedef typename Lanes::V V;
+			const int width = Lanes::width;
+			// Only the vectors up to the highest occupied order are read
+			int n = (highestSlot(occupied) / width + 1) * width;
+			V best = Lanes::load(keys);
+			for (int i = width; i < n; i += width) {
+				best = Lanes::min(best, Lanes::load(keys + i));
+			}
+			alignas(32) T lanes[width];
+			Lanes::store(lanes, best);
+			T m = lanes[0];
+			for (int i = 1; i < width; i++) {
+				if (lanes[i] < m) m = lanes[i];
+			}
+			V target = Lanes::splat(m);
+			std::uint64_t hits = 0;
+			for (int i = 0; i < n; i += width) {
+				hits |= std::uint64_t(Lanes::eq(Lanes::load(keys + i), target)) << i;
+			}
+			hits &= occupied;
+			// hits is only empty for NaN keys, which std::less cannot order anyway
+			return lowestSlot(hits ? hits : occupied);
+		}
+		else {
+			int best = lowestSlot(occupied);
+			for (std::uint64_t rest = occupied & (occupied - 1); rest != 0; rest &= rest - 1) {
+				int s = lowestSlot(rest);
+				if (keys[s] < keys[best]) best = s;
+			}
+			return best;
+		}
+	}
+
+private:
+	static B emptyKey() {
+		return std::numeric_limits<B>::has_infinity ? std::numeric_limits<B>::infinity() : std::numeric_limits<B>::max();
+	}
+	static int lowestSlot(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(bits);
+#elif defined(_MSC_VER)
+		unsigned long k;
+		_BitScanForward64(&k, bits);
+		return int(k);
+#else
+		int k = 0;
+		while ((bits & 1) == 0) {
+			bits >>= 1;
+			k++;
+		}
+		return k;
+#endif
+	}
+	static int highestSlot(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+		return 63 - __builtin_clzll(bits);
+#elif defined(_MSC_VER)
+		unsigned long k;
+		_BitScanReverse64(&k, bits);
+		return int(k);
+#else
+		int k = 63;
+		while ((bits >> k) == 0) {
+			k--;
+		}
+		return k;
+#endif
+	}
+
+	alignas(32) B keys[64];
+};
+
+#endif /* BINOMIALHEAPSIMD_H_ */
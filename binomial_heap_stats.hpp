@@ -0,0 +1,53 @@
+#ifndef BINOMIALHEAPSTATS_H_
+#define BINOMIALHEAPSTATS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Statistics policies for BinomialHeap. The heap calls these hooks from its
+// hot paths; with NoHeapStats every hook is an empty inline function on an
+// empty base class, so instrumentation costs nothing unless it is asked for.
+
+struct NoHeapStats
+{
+	void onCompare() {}
+	void onLink() {}
+	void onSiftStep() {}
+	void onRootScan(std::size_t) {}
+	void onAllocate() {}
+	void onDeallocate(std::size_t) {}
+};
+
+// Plain counters, read back through BinomialHeap::getStats()
+struct CountingHeapStats
+{
+	std::uint64_t comparisons = 0;    // calls to the Compare functor; a SIMD root
+	                                  // scan counts the roots - 1 compares the
+	                                  // scalar scan would make, so the count does
+	                                  // not depend on the key type
+	std::uint64_t links = 0;          // trees linked under an equal-order root
+	std::uint64_t siftSteps = 0;      // levels climbed by decreaseKey / erase
+	std::uint64_t rootScans = 0;      // min scans and consolidations over the roots
+	std::uint64_t rootsScanned = 0;   // roots visited by those passes (set bits of
+	                                  // the order-indexed array plus pending roots)
+	std::uint64_t maxRootListLength = 0; // most roots seen by one pass
+	std::uint64_t allocations = 0;    // nodes created
+	std::uint64_t deallocations = 0;  // nodes released
+
+	void onCompare() { comparisons++; }
+	void onLink() { links++; }
+	void onSiftStep() { siftSteps++; }
+	void onRootScan(std::size_t length) {
+		rootScans++;
+		rootsScanned += length;
+		if (length > maxRootListLength) {
+			maxRootListLength = length;
+		}
+	}
+	void onAllocate() { allocations++; }
+	void onDeallocate(std::size_t n) { deallocations += n; }
+
+	void reset() { *this = CountingHeapStats(); }
+};
+
+#endif /* BINOMIALHEAPSTATS_H_ */
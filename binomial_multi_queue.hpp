@@ -0,0 +1,206 @@
+#ifndef BINOMIALMULTIQUEUE_H_
+#define BINOMIALMULTIQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "binomial_heap.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define BINOMIAL_MQ_PAUSE() _mm_pause()
+#else
+#define BINOMIAL_MQ_PAUSE() ((void)0)
+#endif
+
+// Test-and-test-and-set spinlock, one cache line per shard
+class ShardSpinLock
+{
+public:
+	ShardSpinLock() : locked(false) {}
+
+	bool tryLock() {
+		return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+	}
+
+	void lock() {
+		for (unsigned spins = 0; !tryLock(); spins++) {
+			if (spins < 64) {
+				BINOMIAL_MQ_PAUSE();
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void unlock() { locked.store(false, std::memory_order_release); }
+
+private:
+	std::atomic<bool> locked;
+};
+
+// Releases an already acquired ShardSpinLock when it goes out of scope, so a
+// throwing key constructor or bad_alloc cannot leave a shard locked
+class ShardLockGuard
+{
+public:
+	explicit ShardLockGuard(ShardSpinLock& lock) : lock(lock) {}
+	ShardLockGuard(const ShardLockGuard&) = delete;
+	ShardLockGuard& operator=(const ShardLockGuard&) = delete;
+	~ShardLockGuard() { lock.unlock(); }
+
+private:
+	ShardSpinLock& lock;
+};
+
+// Relaxed concurrent priority queue (MultiQueue): c * P BinomialHeap shards,
+// each behind its own spinlock. insert() goes to a random shard; tryExtractMin()
+// locks two random shards and pops the smaller of their minimums. Threads
+// rarely meet on the same shard, so throughput grows with the thread count,
+// at the price of order: an extracted element is not always the global
+// minimum, but its expected rank is O(shard count).
+//
+// Each shard is a full BinomialHeap object (about 1 KB with its order-indexed
+// root array), so memory grows by that much per shard before any element.
+//
+// Only insert / extract are offered. Per-element handles would point into a
+// shard that other threads keep modifying, so there is no decreaseKey/erase.
+template <typename B, typename Compare = std::less<B>, typename Allocator = NewDeleteNodeAllocator<B>>
+class BinomialMultiQueue : private CompareHolder<Compare>
+{
+public:
+	typedef BinomialHeap<B, Compare, Allocator> Heap;
+
+	// threads * shardsPerThread shards (at least two)
+	explicit BinomialMultiQueue(std::size_t threads, std::size_t shardsPerThread = 2, const Compare& comp = Compare())
+		: CompareHolder<Compare>(comp), shardCount(threads * shardsPerThread < 2 ? 2 : threads * shardsPerThread),
+		  shards(new Shard[shardCount]) {
+		for (std::size_t i = 0; i < shardCount; i++) {
+			shards[i].heap = Heap(comp);
+		}
+	}
+
+	BinomialMultiQueue(const BinomialMultiQueue&) = delete;
+	BinomialMultiQueue& operator=(const BinomialMultiQueue&) = delete;
+
+	void insert(const B& value) { emplace(value); }
+	void insert(B&& value) { emplace(std::move(value)); }
+
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		Shard* shard;
+		do {
+			shard = &shards[randomShard()];
+		} while (!shard->lock.tryLock()); // busy shard: pick another instead of waiting
+		ShardLockGuard guard(shard->lock);
+		shard->heap.emplace(std::forward<Args>(args)...);
+		shard->size.store(shard->heap.size(), std::memory_order_relaxed);
+	}
+
+	// Pops a small (not necessarily the smallest) element into out. Every pop
+	// compares the minimums of two shards: a pair with a busy shard is dropped
+	// and another pair drawn, rather than popping the one shard that locked.
+	// Returns false only after a sweep under all locks found every shard empty.
+	bool tryExtractMin(B& out) {
+		for (unsigned attempt = 0; attempt < 2 * shardCount; attempt++) {
+			std::size_t i = randomShard();
+			std::size_t j = randomShard();
+			if (i == j) {
+				j = (j + 1) % shardCount;
+			}
+			Shard* a = &shards[i];
+			Shard* b = &shards[j];
+			// Skip visibly empty pairs and never wait on a busy shard
+			if (a->size.load(std::memory_order_relaxed) == 0 && b->size.load(std::memory_order_relaxed) == 0) continue;
+			if (!a->lock.tryLock()) continue;
+			ShardLockGuard guardA(a->lock);
+			if (!b->lock.tryLock()) continue;
+			ShardLockGuard guardB(b->lock);
+			Shard* pick = a;
+			if (a->heap.isEmpty() || (!b->heap.isEmpty() && less(b->heap.getMin(), a->heap.getMin()))) {
+				pick = b;
+			}
+			if (popLocked(*pick, out)) {
+				return true;
+			}
+		}
+		// Many misses in a row: lock every shard in index order (so two sweeps
+		// cannot deadlock) and pop the overall minimum, or report empty
+		std::size_t held = 0;
+		struct SweepGuard {
+			Shard* shards;
+			std::size_t& held;
+			~SweepGuard() {
+				for (std::size_t k = 0; k < held; k++) shards[k].lock.unlock();
+			}
+		} sweep{ shards.get(), held };
+		Shard* pick = nullptr;
+		for (std::size_t k = 0; k < shardCount; k++) {
+			Shard& s = shards[k];
+			s.lock.lock();
+			held = k + 1;
+			if (!s.heap.isEmpty() && (pick == nullptr || less(s.heap.getMin(), pick->heap.getMin()))) {
+				pick = &s;
+			}
+		}
+		return pick != nullptr && popLocked(*pick, out);
+	}
+
+	// Approximate while other threads are running
+	std::size_t size() const {
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < shardCount; i++) {
+			total += shards[i].size.load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+	bool isEmpty() const { return size() == 0; }
+
+	std::size_t getShardCount() const { return shardCount; }
+
+private:
+	struct alignas(64) Shard {
+		ShardSpinLock lock;
+		std::atomic<std::size_t> size{ 0 }; // readable without the lock
+		Heap heap;
+	};
+
+	bool less(const B& a, const B& b) const { return this->comparator()(a, b); }
+
+	// Pops from a shard the caller has locked; the caller's guard unlocks it
+	bool popLocked(Shard& s, B& out) {
+		if (s.heap.isEmpty()) {
+			return false;
+		}
+		out = s.heap.extractMin();
+		s.size.store(s.heap.size(), std::memory_order_relaxed);
+		return true;
+	}
+
+	// Per-thread xorshift generator; no shared state between threads
+	std::size_t randomShard() {
+		thread_local std::uint64_t state = 0;
+		if (state == 0) {
+			// splitmix64 of the thread id, so neighbouring ids get unrelated streams
+			std::uint64_t z = std::hash<std::thread::id>()(std::this_thread::get_id()) + 0x9E3779B97F4A7C15ull;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			state = (z ^ (z >> 31)) | 1;
+		}
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return std::size_t((state >> 32) * shardCount >> 32);
+	}
+
+	std::size_t shardCount;
+	std::unique_ptr<Shard[]> shards;
+};
+
+#endif /* BINOMIALMULTIQUEUE_H_ */
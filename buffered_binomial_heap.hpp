@@ -0,0 +1,161 @@
+#ifndef BUFFEREDBINOMIALHEAP_H_
+#define BUFFEREDBINOMIALHEAP_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include "binomial_heap.hpp"
+
+// A shared BinomialHeap fed by per-producer staging heaps. Each producer
+// inserts into its own heap without any locking (lazy mode, O(1) per insert)
+// and splices the whole batch into the shared heap with one merge, which is
+// O(log n) under the lock, when
+//   - it has staged flushThreshold elements,
+//   - its oldest staged element is older than maxDelay (checked on insert),
+//   - a consumer found the shared heap empty or called requestFlush()
+//     (noticed on the producer's next insert or poll()), or
+//   - it calls flush() or is destroyed.
+// Consumers lock the shared heap for every extraction. An idle producer keeps
+// its staged elements until it next inserts, polls or flushes.
+//
+// Spliced nodes are freed by the shared heap, which never allocates, so only
+// allocators that return each node individually (NewDeleteNodeAllocator) are
+// accepted: with a pool the freed slots would sit on the shared heap's free
+// list while every producer keeps carving new slabs.
+template <typename B, typename Compare = std::less<B>, typename Allocator = NewDeleteNodeAllocator<B>>
+class BufferedBinomialHeap
+{
+	static_assert(!Allocator::releasesInBulk,
+		"BufferedBinomialHeap needs a per-node allocator; pooled slots would pile up in the shared heap");
+
+public:
+	typedef BinomialHeap<B, Compare, Allocator> Heap;
+	typedef std::chrono::steady_clock Clock;
+
+	class Producer;
+
+	explicit BufferedBinomialHeap(std::size_t flushThreshold = 1024,
+		std::chrono::microseconds maxDelay = std::chrono::microseconds(1000), const Compare& comp = Compare())
+		: shared(comp), flushThreshold(flushThreshold ? flushThreshold : 1), maxDelay(maxDelay), flushEpoch(0) {}
+
+	BufferedBinomialHeap(const BufferedBinomialHeap&) = delete;
+	BufferedBinomialHeap& operator=(const BufferedBinomialHeap&) = delete;
+
+	// Pops the shared minimum; staged elements are not visible until flushed.
+	// An empty shared heap asks every producer to flush.
+	bool tryExtractMin(B& out) {
+		std::lock_guard<std::mutex> guard(mutex);
+		if (shared.isEmpty()) {
+			requestFlush();
+			return false;
+		}
+		out = shared.extractMin();
+		return true;
+	}
+
+	bool tryGetMin(B& out) {
+		std::lock_guard<std::mutex> guard(mutex);
+		if (shared.isEmpty()) {
+			return false;
+		}
+		out = shared.getMin();
+		return true;
+	}
+
+	// Asks producers to hand over their staged elements
+	void requestFlush() { flushEpoch.fetch_add(1, std::memory_order_relaxed); }
+
+	// Elements already in the shared heap
+	std::size_t size() {
+		std::lock_guard<std::mutex> guard(mutex);
+		return shared.size();
+	}
+
+	std::size_t getFlushThreshold() const { return flushThreshold; }
+	std::chrono::microseconds getMaxDelay() const { return maxDelay; }
+
+private:
+	void splice(Heap& staged) {
+		staged.consolidate(); // outside the lock, so the critical section is just the meld
+		std::lock_guard<std::mutex> guard(mutex);
+		shared.merge(staged);
+	}
+
+	std::mutex mutex;
+	Heap shared;
+	const std::size_t flushThreshold;
+	const std::chrono::microseconds maxDelay;
+	std::atomic<std::uint64_t> flushEpoch;
+};
+
+// Staging heap owned by one producer thread. Each one embeds a BinomialHeap
+// object (about 1 KB with its order-indexed root array).
+template <typename B, typename Compare, typename Allocator>
+class BufferedBinomialHeap<B, Compare, Allocator>::Producer
+{
+public:
+	explicit Producer(BufferedBinomialHeap& target)
+		: target(target), staged(target.shared.getCompare()),
+		  seenEpoch(target.flushEpoch.load(std::memory_order_relaxed)), sinceClockCheck(0) {
+		staged.setInsertMode(Heap::LAZY);
+	}
+
+	Producer(const Producer&) = delete;
+	Producer& operator=(const Producer&) = delete;
+
+	~Producer() { flush(); }
+
+	void insert(const B& value) { emplace(value); }
+	void insert(B&& value) { emplace(std::move(value)); }
+
+	template <typename... Args>
+	void emplace(Args&&... args) {
+		if (staged.isEmpty()) {
+			oldest = Clock::now();
+			sinceClockCheck = 0;
+		}
+		staged.emplace(std::forward<Args>(args)...);
+		poll();
+	}
+
+	// Flushes if a threshold was reached or a consumer asked; true if it did
+	bool poll() {
+		if (staged.isEmpty()) {
+			seenEpoch = target.flushEpoch.load(std::memory_order_relaxed);
+			return false;
+		}
+		bool due = staged.size() >= target.flushThreshold
+			|| target.flushEpoch.load(std::memory_order_relaxed) != seenEpoch;
+		// Reading the clock costs more than a staged insert, so only look every 16
+		if (!due && ++sinceClockCheck >= 16) {
+			sinceClockCheck = 0;
+			due = Clock::now() - oldest >= target.maxDelay;
+		}
+		if (due) {
+			flush();
+		}
+		return due;
+	}
+
+	void flush() {
+		seenEpoch = target.flushEpoch.load(std::memory_order_relaxed);
+		if (!staged.isEmpty()) {
+			target.splice(staged);
+		}
+	}
+
+	std::size_t stagedSize() const { return staged.size(); }
+
+private:
+	BufferedBinomialHeap& target;
+	Heap staged;
+	std::uint64_t seenEpoch;
+	Clock::time_point oldest;
+	unsigned sinceClockCheck;
+};
+
+#endif /* BUFFEREDBINOMIALHEAP_H_ */
@@ -0,0 +1,327 @@
+#ifndef COMPACTBINOMIALHEAP_H_
+#define COMPACTBINOMIALHEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "binomial_heap_compare.hpp"
+
+// Binomial heap whose nodes live in one contiguous array and refer to each
+// other by 32-bit index, with the order packed into a byte. For an int key a
+// node is 24 bytes plus a 4-byte handle slot, against roughly 90 bytes for a
+// BinomialHeap node, its locator and two allocator headers, and neighbouring
+// nodes share cache lines instead of being scattered across the heap.
+//
+// Handles are indices into a separate handle table. Keys move between nodes
+// during decreaseKey / erase, and the table entries move with them, so a
+// handle stays attached to its element. Freed node and handle slots are
+// reused by later inserts. Holds at most 2^32 - 2 elements.
+//
+// As with BinomialHeap::Handle, a handle is valid only until its element
+// leaves the heap. Using it afterwards throws "Invalid handle" while its slot
+// is still free, but once a later insert reuses the slot the handle names
+// that new element, so do not keep handles of removed elements.
+//
+// merge() copies the other heap's nodes into this array, so it is O(m) in
+// the size of the absorbed heap rather than O(log n).
+template <typename B, typename Compare = std::less<B>>
+class CompactBinomialHeap : private CompareHolder<Compare>
+{
+public:
+	typedef std::uint32_t Handle;
+	static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+	CompactBinomialHeap() : head(NIL), minNode(NIL), freeNodes(NIL), freeHandles(NIL), count(0) {}
+	explicit CompactBinomialHeap(const Compare& comp)
+		: CompareHolder<Compare>(comp), head(NIL), minNode(NIL), freeNodes(NIL), freeHandles(NIL), count(0) {}
+
+	Handle insert(const B& value) { return insertNode(allocate(value)); }
+	Handle insert(B&& value) { return insertNode(allocate(std::move(value))); }
+
+	const B& getMin() const {
+		if (minNode == NIL) {
+			throw std::runtime_error("Cannot get min from empty heap");
+		}
+		return nodes[minNode].value;
+	}
+
+	B extractMin() {
+		if (minNode == NIL) {
+			throw std::runtime_error("Cannot extract min from empty heap");
+		}
+		B value = std::move(nodes[minNode].value);
+		removeRoot(minNode);
+		return value;
+	}
+
+	void decreaseKey(Handle handle, B newValue) {
+		std::uint32_t node = nodeOf(handle);
+		if (!less(newValue, nodes[node].value)) {
+			throw std::runtime_error("New value must be smaller than current value");
+		}
+		nodes[node].value = std::move(newValue);
+		node = siftUp(node, false);
+		if (nodes[node].parent == NIL && less(nodes[node].value, nodes[minNode].value)) {
+			minNode = node;
+		}
+	}
+
+	void erase(Handle handle) {
+		removeRoot(siftUp(nodeOf(handle), true));
+	}
+
+	// Moves every element of other into this heap and leaves other empty.
+	// A handle h of other refers to the same element here as h + the returned
+	// offset.
+	Handle merge(CompactBinomialHeap& other) {
+		if (this == &other || other.count == 0) {
+			return 0;
+		}
+		if (nodes.size() + other.nodes.size() >= NIL - 1 || handles.size() + other.handles.size() >= NIL - 1) {
+			throw std::runtime_error("CompactBinomialHeap is full");
+		}
+		nodes.reserve(nodes.size() + other.nodes.size());
+		handles.reserve(handles.size() + other.handles.size());
+
+		std::uint32_t nodeBase = std::uint32_t(nodes.size());
+		std::uint32_t handleBase = std::uint32_t(handles.size());
+		auto shift = [](std::uint32_t i, std::uint32_t base) { return i == NIL ? NIL : i + base; };
+		// Live handle entries hold node indices, free ones link to other handles
+		for (std::uint32_t h = 0; h < other.handles.size(); h++) {
+			handles.push_back(other.isLive(h) ? other.handles[h] + nodeBase : shift(other.handles[h], handleBase));
+		}
+		for (Node& n : other.nodes) {
+			nodes.push_back(Node{ std::move(n.value), shift(n.sibling, nodeBase), shift(n.child, nodeBase),
+				shift(n.parent, nodeBase), shift(n.handle, handleBase), n.order });
+		}
+
+		// other's free slots go in front of ours
+		if (other.freeNodes != NIL) {
+			std::uint32_t tail = other.freeNodes + nodeBase;
+			while (nodes[tail].sibling != NIL) {
+				tail = nodes[tail].sibling;
+			}
+			nodes[tail].sibling = freeNodes;
+			freeNodes = other.freeNodes + nodeBase;
+		}
+		if (other.freeHandles != NIL) {
+			std::uint32_t tail = other.freeHandles + handleBase;
+			while (handles[tail] != NIL) {
+				tail = handles[tail];
+			}
+			handles[tail] = freeHandles;
+			freeHandles = other.freeHandles + handleBase;
+		}
+
+		std::uint32_t trees[64];
+		for (std::uint32_t& t : trees) {
+			t = NIL;
+		}
+		std::uint32_t lists[2] = { head, shift(other.head, nodeBase) };
+		for (std::uint32_t r : lists) {
+			while (r != NIL) {
+				std::uint32_t next = nodes[r].sibling;
+				carry(trees, r);
+				r = next;
+			}
+		}
+		chainRoots(trees);
+		count += other.count;
+		other.clear();
+		return handleBase;
+	}
+
+	const B& getValue(Handle handle) const { return nodes[nodeOf(handle)].value; }
+	Handle getMinHandle() const { return minNode == NIL ? NIL : nodes[minNode].handle; }
+
+	std::size_t size() const { return count; }
+	bool isEmpty() const { return count == 0; }
+
+	// Preallocates room for n elements
+	void reserve(std::size_t n) {
+		nodes.reserve(n);
+		handles.reserve(n);
+	}
+
+	void clear() {
+		nodes.clear();
+		handles.clear();
+		head = minNode = freeNodes = freeHandles = NIL;
+		count = 0;
+	}
+
+	// Bytes held by the node and handle arrays
+	std::size_t memoryUsage() const {
+		return nodes.capacity() * sizeof(Node) + handles.capacity() * sizeof(std::uint32_t);
+	}
+
+private:
+	struct Node {
+		B value;
+		std::uint32_t sibling; // next root, or next (smaller-order) child; free-list link when unused
+		std::uint32_t child;   // highest-order child first, as in BinomialHeap
+		std::uint32_t parent;
+		std::uint32_t handle;  // slot in handles that points back here
+		std::uint8_t order;
+	};
+
+	bool less(const B& a, const B& b) const { return this->comparator()(a, b); }
+
+	// Free handle slots hold a free-list link instead, and released nodes
+	// carry handle NIL, so a free slot never points at a node that points back
+	bool isLive(Handle handle) const {
+		std::uint32_t n = handles[handle];
+		return n < nodes.size() && nodes[n].handle == handle;
+	}
+
+	std::uint32_t nodeOf(Handle handle) const {
+		if (handle >= handles.size() || !isLive(handle)) {
+			throw std::runtime_error("Invalid handle");
+		}
+		return handles[handle];
+	}
+
+	template <typename V>
+	std::uint32_t allocate(V&& value) {
+		std::uint32_t h = freeHandles;
+		if (h != NIL) {
+			freeHandles = handles[h];
+		}
+		else {
+			if (handles.size() >= NIL - 1) {
+				throw std::runtime_error("CompactBinomialHeap is full");
+			}
+			h = std::uint32_t(handles.size());
+			handles.push_back(NIL);
+		}
+		std::uint32_t n = freeNodes;
+		if (n != NIL) {
+			freeNodes = nodes[n].sibling;
+			nodes[n] = Node{ std::forward<V>(value), NIL, NIL, NIL, h, 0 };
+		}
+		else {
+			n = std::uint32_t(nodes.size());
+			nodes.push_back(Node{ std::forward<V>(value), NIL, NIL, NIL, h, 0 });
+		}
+		handles[h] = n;
+		return n;
+	}
+
+	void release(std::uint32_t n) {
+		std::uint32_t h = nodes[n].handle;
+		handles[h] = freeHandles;
+		freeHandles = h;
+		nodes[n].handle = NIL;
+		nodes[n].sibling = freeNodes;
+		freeNodes = n;
+	}
+
+	// Makes the root with the larger key a child of the other; ties keep a on top
+	std::uint32_t link(std::uint32_t a, std::uint32_t b) {
+		if (less(nodes[b].value, nodes[a].value)) {
+			std::swap(a, b);
+		}
+		nodes[b].parent = a;
+		nodes[b].sibling = nodes[a].child;
+		nodes[a].child = b;
+		nodes[a].order++;
+		return a;
+	}
+
+	Handle insertNode(std::uint32_t n) {
+		if (minNode == NIL || less(nodes[n].value, nodes[minNode].value)) {
+			minNode = n;
+		}
+		// Binary-counter increment along the order-sorted root list
+		std::uint32_t tree = n;
+		while (head != NIL && nodes[head].order == nodes[tree].order) {
+			std::uint32_t next = nodes[head].sibling;
+			tree = link(head, tree);
+			head = next;
+		}
+		nodes[tree].sibling = head;
+		head = tree;
+		while (nodes[minNode].parent != NIL) {
+			minNode = nodes[minNode].parent; // an equal key absorbed the min root
+		}
+		count++;
+		return nodes[n].handle;
+	}
+
+	void swapEntries(std::uint32_t a, std::uint32_t b) {
+		std::swap(nodes[a].value, nodes[b].value);
+		std::swap(nodes[a].handle, nodes[b].handle);
+		handles[nodes[a].handle] = a;
+		handles[nodes[b].handle] = b;
+	}
+
+	std::uint32_t siftUp(std::uint32_t node, bool toRoot) {
+		std::uint32_t parent = nodes[node].parent;
+		while (parent != NIL && (toRoot || less(nodes[node].value, nodes[parent].value))) {
+			swapEntries(node, parent);
+			node = parent;
+			parent = nodes[node].parent;
+		}
+		return node;
+	}
+
+	void carry(std::uint32_t* trees, std::uint32_t tree) {
+		nodes[tree].sibling = NIL;
+		nodes[tree].parent = NIL;
+		int k = nodes[tree].order;
+		while (trees[k] != NIL) {
+			tree = link(trees[k], tree);
+			trees[k] = NIL;
+			k++;
+		}
+		trees[k] = tree;
+	}
+
+	void removeRoot(std::uint32_t root) {
+		std::uint32_t trees[64];
+		for (std::uint32_t& t : trees) {
+			t = NIL;
+		}
+		for (std::uint32_t r = head; r != NIL;) {
+			std::uint32_t next = nodes[r].sibling;
+			if (r != root) {
+				carry(trees, r);
+			}
+			r = next;
+		}
+		for (std::uint32_t c = nodes[root].child; c != NIL;) {
+			std::uint32_t next = nodes[c].sibling;
+			carry(trees, c);
+			c = next;
+		}
+		release(root);
+		count--;
+		chainRoots(trees);
+	}
+
+	// Chains trees from the highest order down, tracking the new minimum
+	void chainRoots(const std::uint32_t* trees) {
+		head = NIL;
+		minNode = NIL;
+		for (int k = 63; k >= 0; k--) {
+			if (trees[k] == NIL) continue;
+			nodes[trees[k]].sibling = head;
+			head = trees[k];
+			if (minNode == NIL || less(nodes[head].value, nodes[minNode].value)) {
+				minNode = head;
+			}
+		}
+	}
+
+	std::vector<Node> nodes;
+	std::vector<std::uint32_t> handles; // handle -> node index; free-list link when unused
+	std::uint32_t head;                 // roots sorted by increasing order
+	std::uint32_t minNode;
+	std::uint32_t freeNodes, freeHandles;
+	std::size_t count;
+};
+
+#endif /* COMPACTBINOMIALHEAP_H_ */
@@ -0,0 +1,302 @@
+#ifndef INDEXEDBINOMIALHEAP_H_
+#define INDEXEDBINOMIALHEAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "binomial_heap.hpp"
+
+// Open-addressing multimap from key to heap handle (linear probing with
+// backward-shift deletion). Entries store the handle and the key's hash, not
+// the key: the key is read through the handle, which follows its element
+// through every sift-up swap and tree link, so only inserting, removing or
+// re-keying an element has to touch the table.
+template <typename B, typename Handle, typename Hash, typename KeyEqual>
+class HandleIndex
+{
+public:
+	HandleIndex() : used(0) {}
+	HandleIndex(const HandleIndex&) = default;
+	HandleIndex& operator=(const HandleIndex&) = default;
+	// A moved-from index is empty, not a table with no slots and a nonzero count
+	HandleIndex(HandleIndex&& other) noexcept
+		: slots(std::move(other.slots)), used(other.used), hasher(std::move(other.hasher)), equal(std::move(other.equal)) {
+		other.clear();
+	}
+	HandleIndex& operator=(HandleIndex&& other) noexcept {
+		if (this != &other) {
+			slots = std::move(other.slots);
+			used = other.used;
+			hasher = std::move(other.hasher);
+			equal = std::move(other.equal);
+			other.clear();
+		}
+		return *this;
+	}
+
+	void insert(Handle handle) {
+		if ((used + 1) * 4 > slots.size() * 3) {
+			grow();
+		}
+		place(Slot{ hasher(handle->getValue()), handle });
+		used++;
+	}
+
+	// Must be called while the handle still holds the key it was indexed with
+	void erase(Handle handle) {
+		std::size_t mask = slots.size() - 1;
+		std::size_t i = hasher(handle->getValue()) & mask;
+		while (slots[i].handle != handle) {
+			i = (i + 1) & mask;
+		}
+		// Shift later members of the probe run back so lookups never hit a hole
+		std::size_t j = i;
+		while (true) {
+			j = (j + 1) & mask;
+			if (slots[j].handle == nullptr) break;
+			std::size_t home = slots[j].hash & mask;
+			bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+			if (movable) {
+				slots[i] = slots[j];
+				i = j;
+			}
+		}
+		slots[i] = Slot{ 0, nullptr };
+		used--;
+	}
+
+	Handle find(const B& key) const {
+		if (slots.empty()) return nullptr;
+		std::size_t hash = hasher(key);
+		std::size_t mask = slots.size() - 1;
+		for (std::size_t i = hash & mask; slots[i].handle != nullptr; i = (i + 1) & mask) {
+			if (slots[i].hash == hash && equal(slots[i].handle->getValue(), key)) {
+				return slots[i].handle;
+			}
+		}
+		return nullptr;
+	}
+
+	template <typename OutputIt>
+	OutputIt findAll(const B& key, OutputIt out) const {
+		if (slots.empty()) return out;
+		std::size_t hash = hasher(key);
+		std::size_t mask = slots.size() - 1;
+		for (std::size_t i = hash & mask; slots[i].handle != nullptr; i = (i + 1) & mask) {
+			if (slots[i].hash == hash && equal(slots[i].handle->getValue(), key)) {
+				*out++ = slots[i].handle;
+			}
+		}
+		return out;
+	}
+
+	void clear() {
+		slots.clear();
+		used = 0;
+	}
+
+	std::size_t size() const { return used; }
+
+private:
+	struct Slot {
+		std::size_t hash;
+		Handle handle; // nullptr marks an empty slot
+	};
+
+	void place(const Slot& slot) {
+		std::size_t mask = slots.size() - 1;
+		std::size_t i = slot.hash & mask;
+		while (slots[i].handle != nullptr) {
+			i = (i + 1) & mask;
+		}
+		slots[i] = slot;
+	}
+
+	void grow() {
+		std::vector<Slot> old(slots.size() ? slots.size() * 2 : 16, Slot{ 0, nullptr });
+		old.swap(slots);
+		for (const Slot& slot : old) {
+			if (slot.handle != nullptr) {
+				place(slot);
+			}
+		}
+	}
+
+	std::vector<Slot> slots;
+	std::size_t used;
+	Hash hasher;
+	KeyEqual equal;
+};
+
+// BinomialHeap plus a key -> handle index, so the by-value operations
+// (findKey, decreaseKey, deleteKey) cost O(1) expected for the lookup instead
+// of a DFS over every tree. Duplicate keys are allowed; by-value operations
+// act on one of the matching elements. The index costs one table entry per
+// element, and merge becomes O(m) in the size of the absorbed heap.
+template <typename B, typename Hash = std::hash<B>, typename KeyEqual = std::equal_to<B>,
+	typename Compare = std::less<B>, typename Allocator = NewDeleteNodeAllocator<B>, typename Stats = NoHeapStats>
+class IndexedBinomialHeap : private BinomialHeap<B, Compare, Allocator, Stats>
+{
+public:
+	typedef BinomialHeap<B, Compare, Allocator, Stats> Heap;
+	typedef typename Heap::Handle Handle;
+	typedef typename Heap::InsertMode InsertMode;
+	using Heap::EAGER;
+	using Heap::LAZY;
+
+	IndexedBinomialHeap() {}
+	explicit IndexedBinomialHeap(const Compare& comp) : Heap(comp) {}
+	IndexedBinomialHeap(const IndexedBinomialHeap& other) : Heap(other) { rebuildIndex(); }
+	IndexedBinomialHeap(IndexedBinomialHeap&& other) noexcept = default;
+	IndexedBinomialHeap& operator=(const IndexedBinomialHeap& other) {
+		if (this != &other) {
+			Heap::operator=(other);
+			rebuildIndex();
+		}
+		return *this;
+	}
+	IndexedBinomialHeap& operator=(IndexedBinomialHeap&& other) noexcept = default;
+
+	using Heap::getMin;
+	using Heap::getMinHandle;
+	using Heap::size;
+	using Heap::isEmpty;
+	using Heap::forEachRoot;
+	using Heap::setInsertMode;
+	using Heap::getInsertMode;
+	using Heap::consolidate;
+	using Heap::getStats;
+
+	Handle insert(const B& value) { return track(Heap::insert(value)); }
+	Handle insert(B&& value) { return track(Heap::insert(std::move(value))); }
+	template <typename... Args>
+	Handle emplace(Args&&... args) { return track(Heap::emplace(std::forward<Args>(args)...)); }
+
+	B extractMin() {
+		if (Heap::isEmpty()) {
+			throw std::runtime_error("Cannot extract min from empty heap");
+		}
+		index.erase(Heap::getMinHandle());
+		return Heap::extractMin();
+	}
+
+	// If out throws, the element it was given stays in the heap, so the index
+	// is rebuilt from what is left
+	template <typename OutputIt>
+	OutputIt extractMinBatch(std::size_t k, OutputIt out) {
+		try {
+			return Heap::extractBatch(k, out, [this](BinomialNode<B>* node) { index.erase(node->getLocator()); });
+		}
+		catch (...) {
+			rebuildIndex();
+			throw;
+		}
+	}
+
+	template <typename OutputIt>
+	OutputIt drainSorted(OutputIt out) {
+		try {
+			out = Heap::drainSorted(out);
+		}
+		catch (...) {
+			rebuildIndex();
+			throw;
+		}
+		index.clear();
+		return out;
+	}
+
+	void erase(Handle handle) {
+		if (!handle) {
+			throw std::runtime_error("Invalid handle");
+		}
+		index.erase(handle);
+		Heap::erase(handle);
+	}
+
+	void deleteKey(const B& value) {
+		Handle handle = index.find(value);
+		if (!handle) {
+			throw std::runtime_error("Value not found in heap");
+		}
+		erase(handle);
+	}
+
+	void decreaseKey(Handle handle, B newValue) {
+		if (!handle) {
+			throw std::runtime_error("Invalid handle");
+		}
+		index.erase(handle);
+		try {
+			Heap::decreaseKey(handle, std::move(newValue));
+		}
+		catch (...) {
+			index.insert(handle); // key unchanged, restore its entry
+			throw;
+		}
+		index.insert(handle);
+	}
+
+	void decreaseKey(const B& value, B newValue) {
+		Handle handle = index.find(value);
+		if (!handle) {
+			throw std::runtime_error("Key not found in heap");
+		}
+		decreaseKey(handle, std::move(newValue));
+	}
+
+	// Any one element holding value, or nullptr
+	Handle findKey(const B& value) const { return index.find(value); }
+
+	// Every element holding value
+	template <typename OutputIt>
+	OutputIt findAll(const B& value, OutputIt out) const { return index.findAll(value, out); }
+
+	void merge(IndexedBinomialHeap& other) {
+		if (this == &other) return;
+		indexTrees(other);
+		other.index.clear();
+		Heap::merge(static_cast<Heap&>(other));
+	}
+
+	void merge(IndexedBinomialHeap&& other) { merge(other); }
+
+	void duplicateAndMergeRootTree(const B& rootValue) {
+		BinomialNode<B>* copy = Heap::copyRootTree(rootValue);
+		indexTree(copy);
+		Heap::mergeTree(copy);
+	}
+
+	void clear() {
+		Heap::clear();
+		index.clear();
+	}
+
+private:
+	Handle track(Handle handle) {
+		index.insert(handle);
+		return handle;
+	}
+
+	void indexTree(BinomialNode<B>* node) {
+		index.insert(node->getLocator());
+		for (BinomialNode<B>* c = node->getChild(); c != nullptr; c = c->getSibling()) {
+			indexTree(c);
+		}
+	}
+
+	void indexTrees(const IndexedBinomialHeap& heap) {
+		heap.forEachRoot([this](BinomialNode<B>* root) { indexTree(root); });
+	}
+
+	void rebuildIndex() {
+		index.clear();
+		indexTrees(*this);
+	}
+
+	HandleIndex<B, Handle, Hash, KeyEqual> index;
+};
+
+#endif /* INDEXEDBINOMIALHEAP_H_ */
@@ -0,0 +1,172 @@
+#ifndef PERSISTENTBINOMIALHEAP_H_
+#define PERSISTENTBINOMIALHEAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "binomial_heap_compare.hpp"
+
+// Immutable binomial heap. Every operation leaves the heap it is called on
+// untouched and returns a new version; versions share every subtree the
+// operation did not change through reference-counted nodes. Copying a heap
+// (a snapshot) is O(1), insert/merge/extractMin/duplicateAndMergeRootTree
+// allocate O(log n) new nodes, and old versions stay valid and readable from
+// other threads while a writer keeps producing new ones.
+//
+// Nodes on the rewritten path store their own copy of the key, so keys should
+// be cheap to copy (wrap heavy records in a std::shared_ptr<const T>).
+template <typename B, typename Compare = std::less<B>>
+class PersistentBinomialHeap : private CompareHolder<Compare>
+{
+public:
+	struct Node;
+	typedef std::shared_ptr<const Node> NodePtr;
+
+	struct Node {
+		B value;
+		int order;
+		NodePtr child;   // highest-order child first, as in BinomialHeap
+		NodePtr sibling; // next root (root list) or next smaller child
+	};
+
+	PersistentBinomialHeap() : count(0) {}
+	explicit PersistentBinomialHeap(const Compare& comp) : CompareHolder<Compare>(comp), count(0) {}
+
+	PersistentBinomialHeap insert(B value) const;
+	PersistentBinomialHeap merge(const PersistentBinomialHeap& other) const;
+	PersistentBinomialHeap extractMin() const;
+	// Merges a shared second reference to the tree rooted at rootValue
+	PersistentBinomialHeap duplicateAndMergeRootTree(const B& rootValue) const;
+
+	const B& getMin() const;
+	std::size_t size() const { return count; }
+	bool isEmpty() const { return count == 0; }
+
+	// Read-only access to the root list, for inspection and visualization
+	const Node* getHead() const { return head.get(); }
+
+private:
+	static const int MAX_ORDER = 64;
+
+	bool less(const B& a, const B& b) const { return this->comparator()(a, b); }
+	static NodePtr withSibling(const NodePtr& node, const NodePtr& sibling);
+	NodePtr linkTrees(const NodePtr& a, const NodePtr& b) const;
+	void carryTree(NodePtr* trees, NodePtr tree) const;
+	void collectRoots(NodePtr* trees, const NodePtr& list, const Node* skip) const;
+	PersistentBinomialHeap build(NodePtr* trees, std::size_t newCount) const;
+
+	NodePtr head;    // roots sorted by increasing order
+	NodePtr minRoot; // root holding the smallest key
+	std::size_t count;
+};
+
+template <typename B, typename Compare>
+typename PersistentBinomialHeap<B, Compare>::NodePtr
+PersistentBinomialHeap<B, Compare>::withSibling(const NodePtr& node, const NodePtr& sibling) {
+	if (node->sibling == sibling) {
+		return node; // already linked the right way, share it
+	}
+	return std::make_shared<const Node>(Node{ node->value, node->order, node->child, sibling });
+}
+
+template <typename B, typename Compare>
+typename PersistentBinomialHeap<B, Compare>::NodePtr
+PersistentBinomialHeap<B, Compare>::linkTrees(const NodePtr& a, const NodePtr& b) const {
+	// On ties a stays the root, matching BinomialHeap
+	const NodePtr& root = less(b->value, a->value) ? b : a;
+	const NodePtr& sub = (root == a) ? b : a;
+	return std::make_shared<const Node>(Node{ root->value, root->order + 1, withSibling(sub, root->child), nullptr });
+}
+
+template <typename B, typename Compare>
+void PersistentBinomialHeap<B, Compare>::carryTree(NodePtr* trees, NodePtr tree) const {
+	int k = tree->order;
+	while (trees[k]) {
+		tree = linkTrees(trees[k], tree);
+		trees[k] = nullptr;
+		k++;
+	}
+	trees[k] = tree;
+}
+
+template <typename B, typename Compare>
+void PersistentBinomialHeap<B, Compare>::collectRoots(NodePtr* trees, const NodePtr& list, const Node* skip) const {
+	// A tree's sibling link is ignored here and rebuilt by build()
+	for (NodePtr curr = list; curr; curr = curr->sibling) {
+		if (curr.get() != skip) {
+			carryTree(trees, curr);
+		}
+	}
+}
+
+template <typename B, typename Compare>
+PersistentBinomialHeap<B, Compare> PersistentBinomialHeap<B, Compare>::build(NodePtr* trees, std::size_t newCount) const {
+	PersistentBinomialHeap result(this->comparator());
+	result.count = newCount;
+	// Chain from the highest order down so each root's sibling is final
+	for (int k = MAX_ORDER - 1; k >= 0; k--) {
+		if (!trees[k]) continue;
+		result.head = withSibling(trees[k], result.head);
+		if (!result.minRoot || less(result.head->value, result.minRoot->value)) {
+			result.minRoot = result.head;
+		}
+	}
+	return result;
+}
+
+template <typename B, typename Compare>
+PersistentBinomialHeap<B, Compare> PersistentBinomialHeap<B, Compare>::insert(B value) const {
+	NodePtr trees[MAX_ORDER];
+	collectRoots(trees, head, nullptr);
+	carryTree(trees, std::make_shared<const Node>(Node{ std::move(value), 0, nullptr, nullptr }));
+	return build(trees, count + 1);
+}
+
+template <typename B, typename Compare>
+PersistentBinomialHeap<B, Compare> PersistentBinomialHeap<B, Compare>::merge(const PersistentBinomialHeap& other) const {
+	NodePtr trees[MAX_ORDER];
+	collectRoots(trees, head, nullptr);
+	collectRoots(trees, other.head, nullptr);
+	return build(trees, count + other.count);
+}
+
+template <typename B, typename Compare>
+PersistentBinomialHeap<B, Compare> PersistentBinomialHeap<B, Compare>::extractMin() const {
+	if (!head) {
+		throw std::runtime_error("Cannot extract min from empty heap");
+	}
+	NodePtr trees[MAX_ORDER];
+	collectRoots(trees, head, minRoot.get());
+	collectRoots(trees, minRoot->child, nullptr);
+	return build(trees, count - 1);
+}
+
+template <typename B, typename Compare>
+PersistentBinomialHeap<B, Compare> PersistentBinomialHeap<B, Compare>::duplicateAndMergeRootTree(const B& rootValue) const {
+	NodePtr target;
+	for (NodePtr curr = head; curr; curr = curr->sibling) {
+		if (curr->value == rootValue) {
+			target = curr;
+			break;
+		}
+	}
+	if (!target) {
+		throw std::runtime_error("Root node with specified value not found");
+	}
+	NodePtr trees[MAX_ORDER];
+	collectRoots(trees, head, nullptr);
+	carryTree(trees, target); // the same subtree, shared rather than copied
+	return build(trees, count + (std::size_t(1) << target->order));
+}
+
+template <typename B, typename Compare>
+const B& PersistentBinomialHeap<B, Compare>::getMin() const {
+	if (!minRoot) {
+		throw std::runtime_error("Cannot get min from empty heap");
+	}
+	return minRoot->value;
+}
+
+#endif /* PERSISTENTBINOMIALHEAP_H_ */
@@ -0,0 +1,425 @@
+// Headless trace replay for BinomialHeap.
+//
+// Streams a priority-queue op log from a file (or stdin), executes it against
+// BinomialHeap<std::pair<int64_t, uint64_t>> (key, element id) and reports
+// throughput plus sampled per-op latency percentiles. Parsing is done in
+// chunks outside the timed region, so the numbers cover heap work only.
+//
+// Text log, one op per line ('#' starts a comment):
+//   i <key> <id>    insert element id with key
+//   x               extract min
+//   p               peek at min
+//   d <id> <key>    change id's key (a larger key is replayed as delete + insert)
+//   r <id>          delete id
+//   s <key> <id>    insert into the side heap
+//   m               merge the side heap into the main heap
+//
+// Binary log: the magic "BHTR" followed by records of a one-byte opcode (the
+// letters above) and its operands as little-endian int64 key / uint64 id, in
+// the same order as the text form. --to-binary converts a text log.
+//
+// Element ids index a table of handles, so they should be dense small integers.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "binomial_heap.hpp"
+
+typedef std::pair<std::int64_t, std::uint64_t> Key;
+typedef std::chrono::steady_clock Clock;
+
+static const char BINARY_MAGIC[4] = { 'B', 'H', 'T', 'R' };
+static const std::size_t CHUNK_OPS = 1 << 20;
+
+struct Op {
+	char code;
+	std::int64_t key;
+	std::uint64_t id;
+};
+
+// ---------------------------------------------------------------------------
+// Log readers
+// ---------------------------------------------------------------------------
+
+class TraceReader
+{
+public:
+	TraceReader(std::FILE* in, bool binary) : in(in), binary(binary), line(0) {
+		if (binary) {
+			char magic[4];
+			if (std::fread(magic, 1, 4, in) != 4 || std::memcmp(magic, BINARY_MAGIC, 4) != 0) {
+				throw std::runtime_error("Not a binary trace (missing BHTR header)");
+			}
+		}
+	}
+
+	// Fills ops with up to max ops; returns false once the log is exhausted
+	bool read(std::vector<Op>& ops, std::size_t max) {
+		ops.clear();
+		Op op;
+		while (ops.size() < max && (binary ? readBinary(op) : readText(op))) {
+			ops.push_back(op);
+		}
+		return !ops.empty();
+	}
+
+private:
+	static bool hasKey(char c) { return c == 'i' || c == 'd' || c == 's'; }
+	static bool hasId(char c) { return c == 'i' || c == 'd' || c == 'r' || c == 's'; }
+	static bool known(char c) { return std::strchr("ixpdrsm", c) != nullptr && c != '\0'; }
+
+	bool readText(Op& op) {
+		char buf[256];
+		while (std::fgets(buf, sizeof(buf), in)) {
+			line++;
+			char* p = buf;
+			while (*p == ' ' || *p == '\t') p++;
+			if (*p == '\0' || *p == '\n' || *p == '\r' || *p == '#') continue;
+			op.code = *p++;
+			op.key = 0;
+			op.id = 0;
+			if (!known(op.code)) fail("unknown op");
+			char* end = p;
+			// 'd' lists the id first, the others the key first
+			if (op.code == 'd') {
+				op.id = std::strtoull(p, &end, 10);
+				if (end == p) fail("missing id");
+				p = end;
+				op.key = std::strtoll(p, &end, 10);
+				if (end == p) fail("missing key");
+			}
+			else {
+				if (hasKey(op.code)) {
+					op.key = std::strtoll(p, &end, 10);
+					if (end == p) fail("missing key");
+					p = end;
+				}
+				if (hasId(op.code)) {
+					op.id = std::strtoull(p, &end, 10);
+					if (end == p) fail("missing id");
+				}
+			}
+			return true;
+		}
+		return false;
+	}
+
+	bool readBinary(Op& op) {
+		int c = std::fgetc(in);
+		if (c == EOF) return false;
+		op.code = char(c);
+		op.key = 0;
+		op.id = 0;
+		if (!known(op.code)) throw std::runtime_error("Corrupt binary trace: unknown opcode");
+		bool ok = true;
+		if (op.code == 'd') {
+			ok = readU64(op.id) && readI64(op.key);
+		}
+		else {
+			if (hasKey(op.code)) ok = readI64(op.key);
+			if (ok && hasId(op.code)) ok = readU64(op.id);
+		}
+		if (!ok) throw std::runtime_error("Corrupt binary trace: truncated record");
+		return true;
+	}
+
+	bool readU64(std::uint64_t& v) {
+		unsigned char b[8];
+		if (std::fread(b, 1, 8, in) != 8) return false;
+		v = 0;
+		for (int i = 7; i >= 0; i--) v = (v << 8) | b[i];
+		return true;
+	}
+
+	bool readI64(std::int64_t& v) {
+		std::uint64_t u;
+		if (!readU64(u)) return false;
+		v = std::int64_t(u);
+		return true;
+	}
+
+	void fail(const char* what) {
+		throw std::runtime_error("Line " + std::to_string(line) + ": " + what);
+	}
+
+	std::FILE* in;
+	bool binary;
+	std::size_t line;
+};
+
+static void writeU64(std::FILE* out, std::uint64_t v) {
+	unsigned char b[8];
+	for (int i = 0; i < 8; i++) {
+		b[i] = (unsigned char)(v >> (8 * i));
+	}
+	std::fwrite(b, 1, 8, out);
+}
+
+static void writeBinary(std::FILE* out, const std::vector<Op>& ops) {
+	for (const Op& op : ops) {
+		std::fputc(op.code, out);
+		switch (op.code) {
+		case 'i':
+		case 's':
+			writeU64(out, std::uint64_t(op.key));
+			writeU64(out, op.id);
+			break;
+		case 'd':
+			writeU64(out, op.id);
+			writeU64(out, std::uint64_t(op.key));
+			break;
+		case 'r':
+			writeU64(out, op.id);
+			break;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Replay
+// ---------------------------------------------------------------------------
+
+struct Options {
+	bool binary = false;
+	bool lazy = false;
+	bool relink = false;
+	bool pool = false;
+	std::size_t sampleEvery = 64;
+	const char* input = "-";
+	const char* toBinary = nullptr;
+};
+
+static const char OP_CODES[] = "ixpdrsm";
+static const int OP_KINDS = 7;
+
+static int opIndex(char code) { return int(std::strchr(OP_CODES, code) - OP_CODES); }
+
+template <typename Allocator>
+class Replayer
+{
+public:
+	typedef BinomialHeap<Key, std::less<Key>, Allocator> Heap;
+	typedef typename Heap::Handle Handle;
+
+	explicit Replayer(const Options& opts) : opts(opts), merges(0), executed(0), elapsedNs(0), increases(0), sink(0) {
+		for (Heap* h : { &heap, &side }) {
+			h->setInsertMode(opts.lazy ? Heap::LAZY : Heap::EAGER);
+			h->setSiftMode(opts.relink ? Heap::RELINK_NODES : Heap::SWAP_KEYS);
+		}
+		for (int k = 0; k < OP_KINDS; k++) counts[k] = 0;
+	}
+
+	void run(const std::vector<Op>& ops) {
+		std::size_t sample = opts.sampleEvery;
+		Clock::time_point start = Clock::now();
+		for (std::size_t i = 0; i < ops.size(); i++) {
+			const Op& op = ops[i];
+			counts[opIndex(op.code)]++;
+			try {
+				if (sample != 0 && (executed + i) % sample == 0) {
+					Clock::time_point t0 = Clock::now();
+					apply(op);
+					samples[opIndex(op.code)].push_back(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+				}
+				else {
+					apply(op);
+				}
+			}
+			catch (const std::exception& e) {
+				throw std::runtime_error("Op " + std::to_string(executed + i + 1) + " ('" + op.code + "'): " + e.what());
+			}
+		}
+		elapsedNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+		executed += ops.size();
+	}
+
+	void report() {
+		double seconds = elapsedNs / 1e9;
+		std::printf("ops          %llu\n", (unsigned long long)executed);
+		std::printf("time         %.3f s\n", seconds);
+		std::printf("throughput   %.0f ops/s\n", seconds > 0 ? executed / seconds : 0.0);
+		std::printf("final size   %zu (side heap %zu)\n", heap.size(), side.size());
+		if (increases) {
+			std::printf("increases    %llu replayed as delete + insert\n", (unsigned long long)increases);
+		}
+		std::printf("\n%-8s %12s %10s %10s %10s %10s %10s  (ns, 1 in %zu sampled)\n",
+			"op", "count", "p50", "p90", "p99", "p99.9", "max", opts.sampleEvery);
+		static const char* names[OP_KINDS] = { "insert", "extract", "peek", "decrease", "delete", "side", "merge" };
+		for (int k = 0; k < OP_KINDS; k++) {
+			if (counts[k] == 0) continue;
+			std::vector<long long>& s = samples[k];
+			std::sort(s.begin(), s.end());
+			std::printf("%-8s %12llu %10lld %10lld %10lld %10lld %10lld\n", names[k], (unsigned long long)counts[k],
+				percentile(s, 0.50), percentile(s, 0.90), percentile(s, 0.99), percentile(s, 0.999),
+				s.empty() ? 0LL : s.back());
+		}
+		std::fprintf(stderr, "checksum %llu\n", (unsigned long long)sink);
+	}
+
+private:
+	static long long percentile(const std::vector<long long>& sorted, double q) {
+		if (sorted.empty()) return 0;
+		return sorted[std::size_t(q * (sorted.size() - 1))];
+	}
+
+	// Handle of a live element of the main heap
+	Handle liveHandle(std::uint64_t id) {
+		if (id >= handles.size() || handles[id] == nullptr) {
+			throw std::runtime_error("Unknown element id " + std::to_string(id));
+		}
+		if (sideEpoch[id] == merges + 1) {
+			throw std::runtime_error("Element id " + std::to_string(id) + " is still in the side heap");
+		}
+		return handles[id];
+	}
+
+	// Side-heap elements are tagged with the number of merges so far plus one;
+	// a merge bumps the count, which moves them all to the main heap in O(1)
+	void add(Heap& h, std::int64_t key, std::uint64_t id, bool toSide) {
+		if (id >= handles.size()) {
+			std::size_t n = std::max<std::size_t>(id + 1, handles.size() * 2);
+			handles.resize(n, nullptr);
+			sideEpoch.resize(n, 0);
+		}
+		if (handles[id] != nullptr) {
+			throw std::runtime_error("Element id " + std::to_string(id) + " is already live");
+		}
+		handles[id] = h.insert(Key(key, id));
+		sideEpoch[id] = toSide ? merges + 1 : 0;
+	}
+
+	void apply(const Op& op) {
+		switch (op.code) {
+		case 'i':
+			add(heap, op.key, op.id, false);
+			break;
+		case 's':
+			add(side, op.key, op.id, true);
+			break;
+		case 'x': {
+			Key k = heap.extractMin();
+			handles[k.second] = nullptr;
+			sink += std::uint64_t(k.first);
+			break;
+		}
+		case 'p':
+			sink += std::uint64_t(heap.getMin().first);
+			break;
+		case 'd': {
+			Handle h = liveHandle(op.id);
+			Key k(op.key, op.id);
+			if (k < h->getValue()) {
+				heap.decreaseKey(h, k);
+			}
+			else if (h->getValue() < k) {
+				increases++;
+				heap.erase(h);
+				handles[op.id] = heap.insert(k);
+			}
+			break;
+		}
+		case 'r':
+			heap.erase(liveHandle(op.id));
+			handles[op.id] = nullptr;
+			break;
+		case 'm':
+			heap.merge(side);
+			merges++;
+			break;
+		}
+	}
+
+	const Options& opts;
+	Heap heap, side;
+	std::vector<Handle> handles;
+	std::vector<std::uint64_t> sideEpoch;
+	std::uint64_t merges;
+	std::uint64_t counts[OP_KINDS];
+	std::vector<long long> samples[OP_KINDS];
+	std::uint64_t executed;
+	long long elapsedNs;
+	std::uint64_t increases;
+	std::uint64_t sink;
+};
+
+template <typename Allocator>
+static void replay(TraceReader& reader, const Options& opts) {
+	Replayer<Allocator> replayer(opts);
+	std::vector<Op> ops;
+	ops.reserve(CHUNK_OPS);
+	while (reader.read(ops, CHUNK_OPS)) {
+		replayer.run(ops);
+	}
+	replayer.report();
+}
+
+static void usage(const char* prog) {
+	std::fprintf(stderr,
+		"usage: %s [options] [trace|-]\n"
+		"  --binary           input is a binary log\n"
+		"  --to-binary FILE   convert the input to a binary log and exit\n"
+		"  --lazy             lazy insert mode\n"
+		"  --relink           relink-nodes sift mode\n"
+		"  --pool             pool node allocator\n"
+		"  --sample N         time one op in N (0 disables, default 64)\n", prog);
+}
+
+int main(int argc, char** argv) {
+	Options opts;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--binary") opts.binary = true;
+		else if (arg == "--lazy") opts.lazy = true;
+		else if (arg == "--relink") opts.relink = true;
+		else if (arg == "--pool") opts.pool = true;
+		else if (arg == "--sample" && i + 1 < argc) opts.sampleEvery = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--to-binary" && i + 1 < argc) opts.toBinary = argv[++i];
+		else if (arg == "-" || arg[0] != '-') opts.input = argv[i];
+		else {
+			usage(argv[0]);
+			return 2;
+		}
+	}
+
+	std::FILE* in = std::strcmp(opts.input, "-") == 0 ? stdin : std::fopen(opts.input, opts.binary ? "rb" : "r");
+	if (in == nullptr) {
+		std::fprintf(stderr, "cannot open %s\n", opts.input);
+		return 1;
+	}
+
+	try {
+		TraceReader reader(in, opts.binary);
+		if (opts.toBinary) {
+			std::FILE* out = std::fopen(opts.toBinary, "wb");
+			if (out == nullptr) {
+				std::fprintf(stderr, "cannot open %s\n", opts.toBinary);
+				return 1;
+			}
+			std::fwrite(BINARY_MAGIC, 1, 4, out);
+			std::vector<Op> ops;
+			while (reader.read(ops, CHUNK_OPS)) {
+				writeBinary(out, ops);
+			}
+			std::fclose(out);
+		}
+		else if (opts.pool) {
+			replay<PoolNodeAllocator<Key>>(reader, opts);
+		}
+		else {
+			replay<NewDeleteNodeAllocator<Key>>(reader, opts);
+		}
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "error: %s\n", e.what());
+		return 1;
+	}
+	return 0;
+}